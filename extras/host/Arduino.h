@@ -0,0 +1,28 @@
+#pragma once
+// Minimal Arduino core stand-in for host (Linux) builds of the library.
+// Time is simulated: micros()/millis() return the host clock, which is advanced
+// by delay()/delayMicroseconds() and by the simulated I2C bus in Wire.h.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdarg>
+#include <cstring>
+#include "HostSerial.h"
+
+#define F(str) (str)
+#define PROGMEM
+#define pgm_read_byte(addr) (*reinterpret_cast<const uint8_t*>(addr))
+#define pgm_read_dword(addr) (*reinterpret_cast<const uint32_t*>(addr))
+
+namespace hostClock {
+    inline uint64_t nanos = 0;
+
+    inline void advanceNanos(uint64_t ns) { nanos += ns; }
+    inline void reset() { nanos = 0; }
+}
+
+inline unsigned long micros() { return static_cast<unsigned long>(hostClock::nanos / 1000u); }
+inline unsigned long millis() { return static_cast<unsigned long>(hostClock::nanos / 1000000u); }
+inline void delayMicroseconds(unsigned int us) { hostClock::advanceNanos(static_cast<uint64_t>(us) * 1000u); }
+inline void delay(unsigned long ms) { hostClock::advanceNanos(static_cast<uint64_t>(ms) * 1000000u); }
@@ -0,0 +1,49 @@
+#pragma once
+// File-backed stand-in for flash/EEPROM preset storage on host builds.
+// Each slot is a fixed REGISTER_COUNT-byte record, so lookup is a single seek.
+
+#include <tda7419.hpp>
+#include <cstdio>
+
+class FilePresetStore {
+public:
+    FilePresetStore(const char* path, uint8_t count) : count(count) {
+        file = std::fopen(path, "r+b");
+        if (file == nullptr) {
+            file = std::fopen(path, "w+b");
+        }
+    }
+
+    ~FilePresetStore() {
+        if (file != nullptr) {
+            std::fclose(file);
+        }
+    }
+
+    FilePresetStore(const FilePresetStore&) = delete;
+    FilePresetStore& operator=(const FilePresetStore&) = delete;
+
+    uint8_t size() const { return count; }
+
+    bool load(uint8_t index, TDA7419::RegisterImage& image) const {
+        if (file == nullptr || index >= count) {
+            return false;
+        }
+        std::fseek(file, static_cast<long>(index) * TDA7419::REGISTER_COUNT, SEEK_SET);
+        return std::fread(image.data(), 1, image.size(), file) == image.size();
+    }
+
+    bool save(uint8_t index, const TDA7419::RegisterImage& image) {
+        if (file == nullptr || index >= count) {
+            return false;
+        }
+        std::fseek(file, static_cast<long>(index) * TDA7419::REGISTER_COUNT, SEEK_SET);
+        const bool ok = std::fwrite(image.data(), 1, image.size(), file) == image.size();
+        std::fflush(file);
+        return ok;
+    }
+
+private:
+    std::FILE* file = nullptr;
+    uint8_t count;
+};
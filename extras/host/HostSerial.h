@@ -0,0 +1,62 @@
+#pragma once
+// Serial stand-in writing to stdout, shared by the host Arduino cores.
+
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+
+constexpr int DEC = 10;
+constexpr int HEX = 16;
+constexpr int BIN = 2;
+
+/**
+ * @brief Serial stand-in writing to stdout (can be silenced for benchmarks).
+ */
+class HostSerial {
+public:
+    bool enabled = true;
+
+    void begin(unsigned long) {}
+
+    void print(const char* s) { if (enabled) std::fputs(s, stdout); }
+    void print(char c) { if (enabled) std::fputc(c, stdout); }
+    void print(unsigned long v, int base = DEC) { printNumber(v, base); }
+    void print(long v, int base = DEC) {
+        if (v < 0 && base == DEC) { print('-'); v = -v; }
+        printNumber(static_cast<unsigned long>(v), base);
+    }
+    void print(int v, int base = DEC) { print(static_cast<long>(v), base); }
+    void print(unsigned int v, int base = DEC) { printNumber(v, base); }
+    void print(uint8_t v, int base = DEC) { printNumber(v, base); }
+    void print(double v) { if (enabled) std::printf("%.2f", v); }
+
+    template<typename T>
+    void println(T v) { print(v); println(); }
+    template<typename T>
+    void println(T v, int base) { print(v, base); println(); }
+    void println() { print('\n'); }
+
+    int printf(const char* fmt, ...) {
+        if (!enabled) return 0;
+        va_list args;
+        va_start(args, fmt);
+        int n = std::vprintf(fmt, args);
+        va_end(args);
+        return n;
+    }
+
+private:
+    void printNumber(unsigned long v, int base) {
+        if (!enabled) return;
+        char buf[33];
+        int i = 0;
+        do {
+            const unsigned digit = v % base;
+            buf[i++] = static_cast<char>(digit < 10 ? '0' + digit : 'A' + digit - 10);
+            v /= base;
+        } while (v > 0);
+        while (i > 0) std::fputc(buf[--i], stdout);
+    }
+};
+
+inline HostSerial Serial;
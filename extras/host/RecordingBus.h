@@ -0,0 +1,51 @@
+#pragma once
+// Recording bus backend for host builds: logs every submission instead of driving a bus.
+// Select it for a whole build with
+//   -DTDA7419_BUS_TYPE=RecordingBus -DTDA7419_BUS_HEADER='"RecordingBus.h"'
+// and reach the log through TDA7419::getBus(). Include tda7419.hpp, not this file.
+
+#include <tda7419Bus.hpp>
+#include <vector>
+
+class RecordingBus {
+public:
+    // One bus submission (a system call on Linux i2c-dev)
+    struct Submission {
+        uint8_t address;
+        std::vector<std::vector<uint8_t>> messages;
+    };
+
+    // false: writeBatch() loops over write(), like a backend without batching
+    bool batching = true;
+
+    uint8_t write(uint8_t address, const uint8_t* data, size_t length) {
+        log.push_back({ address, { std::vector<uint8_t>(data, data + length) } });
+        return 0;
+    }
+
+    void writeBatch(uint8_t address, const TDA7419::BusMessage* messages, uint8_t count, uint8_t* status) {
+        if (!batching) {
+            for (uint8_t i = 0; i < count; ++i) {
+                status[i] = write(address, messages[i].data, messages[i].length);
+            }
+            return;
+        }
+
+        Submission submission{ address, {} };
+        for (uint8_t i = 0; i < count; ++i) {
+            submission.messages.emplace_back(messages[i].data, messages[i].data + messages[i].length);
+            status[i] = 0;
+        }
+        log.push_back(std::move(submission));
+    }
+
+    size_t messageCount() const {
+        size_t n = 0;
+        for (const Submission& s : log) {
+            n += s.messages.size();
+        }
+        return n;
+    }
+
+    std::vector<Submission> log;
+};
@@ -0,0 +1,259 @@
+#pragma once
+// Frequency response of the TDA7419 signal chain for a register image, for tuning tools
+// and regression checks on host builds.
+//
+// The image is decoded through the driver's own getters, then modelled as a cascade of
+// analog second-order sections evaluated at s = j*2*pi*f:
+//   loudness   flat cut of the attenuation; with a center frequency, a low shelf restores
+//              the bass below it (high boost: a broad dip centred on it instead, so both
+//              ends come back up)
+//   bass       peaking filter at the center frequency and Q; low shelf in DC mode
+//   middle     peaking filter at the center frequency and Q
+//   treble     high shelf from the center frequency
+//   subwoofer  Butterworth low-pass at the cut-off (Subwoofer output only)
+//   mixing     Butterworth high-pass with the gain effect as pass-band gain (Mixing output only)
+// The shapes follow the datasheet description, not measured curves; the mixing high-pass
+// corner is not documented and is a model parameter, and the gain effect is assumed to
+// act on the mix input. Control bits are active low.
+//
+// Frequencies and accumulators are kept as separate float arrays (struct of arrays), and
+// each section is applied in one branch-free pass over blocks of eight points, written with
+// GCC/Clang vector types so it is SIMD code at any optimization level. Frequencies are normalized per section so float keeps its precision.
+
+#include <tda7419.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+enum class ResponseOutput : uint8_t {
+    LeftFront,
+    RightFront,
+    LeftRear,
+    RightRear,
+    Subwoofer,
+    Mixing
+};
+
+class ResponseModel {
+public:
+    // H(s) = (b2*s^2 + b1*s + b0) / (a2*s^2 + a1*s + a0), s normalized to f0
+    struct Section {
+        float f0;
+        float b0, b1, b2;
+        float a0, a1, a2;
+    };
+
+    static constexpr uint8_t MAX_SECTIONS = 6;
+    static constexpr float MUTED_DB = -120.0f;
+
+    // Log-spaced grid of points between fMin and fMax
+    ResponseModel(size_t points, float fMin, float fMax) : count(points) {
+        const float ratio = std::log(fMax / fMin) / static_cast<float>(points > 1 ? points - 1 : 1);
+        std::vector<float> grid(points);
+        for (size_t i = 0; i < points; ++i) {
+            grid[i] = fMin * std::exp(ratio * static_cast<float>(i));
+        }
+        setGrid(grid);
+    }
+
+    // Arbitrary grid, e.g. the exact frequencies of a measurement
+    explicit ResponseModel(const std::vector<float>& frequencies) : count(frequencies.size()) {
+        setGrid(frequencies);
+    }
+
+    const float* frequencies() const { return freq.data(); }
+    size_t size() const { return count; }
+
+    // Corner of the mixing high-pass; not given by the datasheet
+    float mixingHighPassHz = 100.0f;
+
+    // Decode a register image (same layout as the device shadow) into sections for an output
+    void load(const TDA7419::RegisterImage& image, ResponseOutput output) {
+        decoder.setRegisterImage(image);
+        sectionCount = 0;
+        gainDb = 0.0f;
+        muted = false;
+
+        if (output == ResponseOutput::Mixing) {
+            // mix input: its own level, HPF gain effect, summed into the front outputs
+            muted = decoder.getMixingEnable() ||
+                (decoder.getMixToLeftFront() && decoder.getMixToRightFront());
+            const float effect = 4.0f + 2.0f * static_cast<float>(decoder.getMixingGainEffect());
+            add(highPass(mixingHighPassHz));
+            gainDb = effect + decoder.getMixingChannelVolume();
+            return;
+        }
+
+        addLoudness();
+
+        const float bass = decoder.getBassLevel();
+        if (bass != 0) {
+            const float f0 = BASS_CENTER_HZ[static_cast<uint8_t>(decoder.getBassCenterFreq())];
+            const float q = BASS_Q[static_cast<uint8_t>(decoder.getBassQFactor())];
+            add(decoder.getBassDcMode() ? peaking(f0, q, bass) : lowShelf(f0, q, bass));
+        }
+
+        const float middle = decoder.getMiddleLevel();
+        if (middle != 0) {
+            add(peaking(MIDDLE_CENTER_HZ[static_cast<uint8_t>(decoder.getMiddleCenterFreq())],
+                MIDDLE_Q[static_cast<uint8_t>(decoder.getMiddleQFactor())], middle));
+        }
+
+        const float treble = decoder.getTrebleLevel();
+        if (treble != 0) {
+            add(highShelf(TREBLE_CENTER_HZ[static_cast<uint8_t>(decoder.getTrebleCenterFreq())], BUTTERWORTH_Q, treble));
+        }
+
+        gainDb += decoder.getInputGain() + decoder.getMasterVolume();
+        if (output == ResponseOutput::Subwoofer) {
+            muted = decoder.getSubwooferEnable();
+            const TDA7419::SubCutoffFreq cutoff = decoder.getSubCutoffFreq();
+            if (cutoff != TDA7419::SubCutoffFreq::Flat) {
+                add(lowPass(SUB_CUTOFF_HZ[static_cast<uint8_t>(cutoff)]));
+            }
+            gainDb += decoder.getSubwooferVolume();
+        }
+        else {
+            gainDb += decoder.getSpeakerVolume(static_cast<TDA7419::SpeakerChannel>(output));
+        }
+    }
+
+    uint8_t getSectionCount() const { return sectionCount; }
+    const Section& getSection(uint8_t index) const { return sections[index]; }
+    float getGainDb() const { return gainDb; }
+    bool isMuted() const { return muted; }
+
+    // Magnitude (dB) and wrapped phase (degrees) of the loaded output at every grid point
+    void evaluate(float* magnitudeDb, float* phaseDeg) {
+        const size_t padded = freq.size();
+        const float* f = freq.data();
+        float* accRe = re.data();
+        float* accIm = im.data();
+
+        for (size_t i = 0; i < padded; ++i) {
+            accRe[i] = 1.0f;
+            accIm[i] = 0.0f;
+        }
+
+        for (uint8_t k = 0; k < sectionCount; ++k) {
+            const Section s = sections[k];
+            const float scale = 1.0f / s.f0;
+            for (size_t i = 0; i < padded; i += BLOCK) {
+                Lanes x, accR, accI;
+                std::memcpy(&x, f + i, sizeof x);
+                std::memcpy(&accR, accRe + i, sizeof accR);
+                std::memcpy(&accI, accIm + i, sizeof accI);
+
+                x *= scale;
+                const Lanes x2 = x * x;
+                const Lanes nr = s.b0 - s.b2 * x2;
+                const Lanes ni = s.b1 * x;
+                const Lanes dr = s.a0 - s.a2 * x2;
+                const Lanes di = s.a1 * x;
+                const Lanes inv = 1.0f / (dr * dr + di * di);
+                const Lanes hr = (nr * dr + ni * di) * inv;
+                const Lanes hi = (ni * dr - nr * di) * inv;
+                const Lanes r = accR * hr - accI * hi;
+                accI = accR * hi + accI * hr;
+
+                std::memcpy(accRe + i, &r, sizeof r);
+                std::memcpy(accIm + i, &accI, sizeof accI);
+            }
+        }
+
+        const float offset = muted ? MUTED_DB : gainDb;
+        for (size_t i = 0; i < count; ++i) {
+            magnitudeDb[i] = 10.0f * std::log10(accRe[i] * accRe[i] + accIm[i] * accIm[i]) + offset;
+        }
+        if (phaseDeg != nullptr) {
+            for (size_t i = 0; i < count; ++i) {
+                phaseDeg[i] = std::atan2(accIm[i], accRe[i]) * RADIANS_TO_DEGREES;
+            }
+        }
+    }
+
+    // Section prototypes (RBJ analog forms); gain in dB
+    static Section peaking(float f0, float q, float db) {
+        const float a = std::pow(10.0f, db / 40.0f);
+        return { f0, 1.0f, a / q, 1.0f, 1.0f, 1.0f / (a * q), 1.0f };
+    }
+
+    static Section lowShelf(float f0, float q, float db) {
+        const float a = std::pow(10.0f, db / 40.0f);
+        const float k = std::sqrt(a) / q;
+        return { f0, a * a, a * k, a, 1.0f, k, a };
+    }
+
+    static Section highShelf(float f0, float q, float db) {
+        const float a = std::pow(10.0f, db / 40.0f);
+        const float k = std::sqrt(a) / q;
+        return { f0, a, a * k, a * a, a, k, 1.0f };
+    }
+
+    static Section lowPass(float f0) {
+        return { f0, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f / BUTTERWORTH_Q, 1.0f };
+    }
+
+    static Section highPass(float f0) {
+        return { f0, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f / BUTTERWORTH_Q, 1.0f };
+    }
+
+private:
+    static constexpr float BUTTERWORTH_Q = 0.70710678f;
+    static constexpr float LOUDNESS_CENTER_HZ[4] = { 0.0f, 400.0f, 800.0f, 2400.0f };
+    static constexpr float BASS_CENTER_HZ[4] = { 60.0f, 80.0f, 100.0f, 200.0f };
+    static constexpr float MIDDLE_CENTER_HZ[4] = { 500.0f, 1000.0f, 1500.0f, 2500.0f };
+    static constexpr float TREBLE_CENTER_HZ[4] = { 10000.0f, 12500.0f, 15000.0f, 17500.0f };
+    static constexpr float SUB_CUTOFF_HZ[4] = { 0.0f, 80.0f, 120.0f, 160.0f };
+    static constexpr float BASS_Q[4] = { 1.0f, 1.25f, 1.5f, 2.0f };
+    static constexpr float MIDDLE_Q[4] = { 0.5f, 0.75f, 1.0f, 1.25f };
+    static constexpr float HIGH_BOOST_Q = 0.5f;
+    static constexpr float RADIANS_TO_DEGREES = 57.2957795f;
+
+    // points evaluated together; the arrays are padded to whole blocks (repeating the last frequency)
+    static constexpr size_t BLOCK = 8;
+    typedef float Lanes __attribute__((vector_size(BLOCK * sizeof(float))));
+
+    void setGrid(const std::vector<float>& grid) {
+        const size_t padded = (grid.size() + BLOCK - 1) / BLOCK * BLOCK;
+        freq.assign(grid.begin(), grid.end());
+        freq.resize(padded, grid.empty() ? 1.0f : grid.back());
+        re.resize(padded);
+        im.resize(padded);
+    }
+
+    void add(const Section& section) {
+        sections[sectionCount++] = section;
+    }
+
+    void addLoudness() {
+        const float attenuation = decoder.getLoudnessAttenuation();
+        if (attenuation == 0) {
+            return;
+        }
+
+        const TDA7419::LoudnessCenterFreq center = decoder.getLoudnessCenterFreq();
+        if (center == TDA7419::LoudnessCenterFreq::Flat) {
+            gainDb -= attenuation;
+        }
+        else if (decoder.getLoudnessHighBoost()) {
+            // high boost off: the mid band is cut, the bass below the center is not
+            gainDb -= attenuation;
+            add(lowShelf(LOUDNESS_CENTER_HZ[static_cast<uint8_t>(center)], BUTTERWORTH_Q, attenuation));
+        }
+        else {
+            add(peaking(LOUDNESS_CENTER_HZ[static_cast<uint8_t>(center)], HIGH_BOOST_Q, -attenuation));
+        }
+    }
+
+    TDA7419::TDA7419 decoder;
+    size_t count;
+    std::vector<float> freq;
+    std::vector<float> re;
+    std::vector<float> im;
+    Section sections[MAX_SECTIONS];
+    uint8_t sectionCount = 0;
+    float gainDb = 0.0f;
+    bool muted = false;
+};
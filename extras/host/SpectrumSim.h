@@ -0,0 +1,54 @@
+#pragma once
+// Simulated TDA7419 spectrum analyzer output for host builds.
+// External clock, auto-reset mode: each falling clock edge moves SAOUT to the next
+// band and the band counter wraps after the 7th. SAOUT needs settleMicros after an
+// edge; sampling earlier returns the previous band, like the real RC-loaded pin.
+
+#include <Arduino.h>
+#include <tda7419Spectrum.hpp>
+
+class SpectrumSim {
+public:
+    explicit SpectrumSim(uint16_t settleMicros) : settleNanos(static_cast<uint64_t>(settleMicros) * 1000u) {}
+
+    // Level the simulated programme has in a band for a given frame
+    static uint16_t level(uint32_t frame, uint8_t band) {
+        return static_cast<uint16_t>((band + 1) * 100 + (frame * 7 + band * 13) % 50);
+    }
+
+    static void clock(void* context, bool level) {
+        SpectrumSim& sim = *static_cast<SpectrumSim*>(context);
+        if (sim.clockLevel && !level) {
+            sim.previous = sim.output();
+            if (++sim.band == TDA7419::SPECTRUM_BAND_COUNT) {
+                sim.band = 0;
+                ++sim.frame;
+            }
+            sim.edgeNanos = hostClock::nanos;
+        }
+        sim.clockLevel = level;
+    }
+
+    static uint16_t adc(void* context) {
+        SpectrumSim& sim = *static_cast<SpectrumSim*>(context);
+        ++sim.samples;
+        if (hostClock::nanos - sim.edgeNanos < sim.settleNanos) {
+            ++sim.unsettledSamples;
+            return sim.previous;
+        }
+        return sim.output();
+    }
+
+    uint32_t samples = 0;
+    uint32_t unsettledSamples = 0;
+
+private:
+    uint16_t output() const { return band < 0 ? 0 : level(frame, static_cast<uint8_t>(band)); }
+
+    uint64_t settleNanos;
+    uint64_t edgeNanos = 0;
+    int8_t band = -1;   // before the first edge after reset
+    uint32_t frame = 0;
+    uint16_t previous = 0;
+    bool clockLevel = false;
+};
@@ -0,0 +1,146 @@
+#pragma once
+// TwoWire stand-in for host builds: records every transaction and models its
+// duration on the bus. The host clock (see Arduino.h) is advanced by the
+// simulated bus time on every endTransmission().
+
+#include "Arduino.h"
+#include <vector>
+
+/**
+ * @brief Bus timing model for one I2C speed grade.
+ * @details Times are taken from the I2C specification (UM10204) minimums.
+ */
+struct I2CTiming {
+    uint32_t clockHz;
+    uint32_t startHoldNs;   // tHD;STA - START condition
+    uint32_t stopSetupNs;   // tSU;STO - STOP condition
+    uint32_t busFreeNs;     // tBUF - bus free time between STOP and next START
+
+    static constexpr I2CTiming forClock(uint32_t hz) {
+        return hz <= 100000 ? I2CTiming{ hz, 4000, 4000, 4700 }
+            : hz <= 400000 ? I2CTiming{ hz, 600, 600, 1300 }
+            : I2CTiming{ hz, 260, 260, 500 };
+    }
+
+    /**
+     * @brief Duration of one write transaction on the bus.
+     * @param byteCount Bytes on the wire including the address byte.
+     * @param stretchNsPerByte Clock stretching inserted by the slave after each ACK.
+     * @return uint64_t nanoseconds from START to the earliest next START.
+     */
+    uint64_t transactionNanos(size_t byteCount, uint32_t stretchNsPerByte = 0) const {
+        const uint64_t bitNs = 1000000000ull / clockHz;
+        return startHoldNs + byteCount * (9 * bitNs + stretchNsPerByte) + stopSetupNs + busFreeNs;
+    }
+};
+
+/**
+ * @brief One recorded write transaction.
+ */
+struct I2CTransaction {
+    uint8_t address;
+    std::vector<uint8_t> data;  // payload without the address byte
+    uint8_t result;
+    uint64_t startNs;
+    uint64_t durationNs;
+
+    size_t wireBytes() const { return data.size() + 1; }
+};
+
+/**
+ * @brief Recording TwoWire mock with a cycle-accurate bus time model.
+ */
+class TwoWire {
+public:
+    static constexpr size_t BUFFER_LENGTH = 32;
+
+    void begin() {}
+    void setClock(uint32_t hz) { timing_ = I2CTiming::forClock(hz); }
+    uint32_t getClock() const { return timing_.clockHz; }
+
+    /** @brief Clock stretching applied by the slave after every byte. */
+    void setClockStretch(uint32_t nsPerByte) { stretchNs_ = nsPerByte; }
+
+    /**
+     * @brief Fail the next @p count transactions with the given endTransmission() code.
+     */
+    void injectErrors(uint8_t count, uint8_t code) { failCount_ = count; failCode_ = code; }
+
+    void beginTransmission(uint8_t address) {
+        current_ = I2CTransaction{ address, {}, 0, 0, 0 };
+        overflow_ = false;
+    }
+
+    size_t write(uint8_t value) {
+        if (current_.data.size() >= BUFFER_LENGTH) {
+            overflow_ = true;
+            return 0;
+        }
+        current_.data.push_back(value);
+        return 1;
+    }
+
+    size_t write(const uint8_t* data, size_t length) {
+        size_t written = 0;
+        for (size_t i = 0; i < length; ++i) written += write(data[i]);
+        return written;
+    }
+
+    uint8_t endTransmission(bool sendStop = true) {
+        (void)sendStop;
+        current_.startNs = hostClock::nanos;
+
+        if (overflow_) {
+            current_.result = 1;
+            current_.durationNs = 0;
+        }
+        else {
+            current_.result = 0;
+            if (failCount_ > 0) {
+                --failCount_;
+                current_.result = failCode_;
+            }
+            current_.durationNs = timing_.transactionNanos(current_.wireBytes(), stretchNs_);
+        }
+
+        hostClock::advanceNanos(current_.durationNs);
+        log_.push_back(current_);
+        return current_.result;
+    }
+
+    const std::vector<I2CTransaction>& transactions() const { return log_; }
+    void clearLog() { log_.clear(); }
+
+    size_t totalBytes() const {
+        size_t bytes = 0;
+        for (const auto& t : log_) bytes += t.wireBytes();
+        return bytes;
+    }
+
+    uint64_t totalNanos() const {
+        uint64_t ns = 0;
+        for (const auto& t : log_) ns += t.durationNs;
+        return ns;
+    }
+
+    /**
+     * @brief Re-evaluate the recorded traffic at another clock speed.
+     */
+    uint64_t totalNanosAt(uint32_t hz) const {
+        const I2CTiming timing = I2CTiming::forClock(hz);
+        uint64_t ns = 0;
+        for (const auto& t : log_) ns += timing.transactionNanos(t.wireBytes(), stretchNs_);
+        return ns;
+    }
+
+private:
+    I2CTiming timing_ = I2CTiming::forClock(100000);
+    uint32_t stretchNs_ = 0;
+    uint8_t failCount_ = 0;
+    uint8_t failCode_ = 0;
+    bool overflow_ = false;
+    I2CTransaction current_{};
+    std::vector<I2CTransaction> log_;
+};
+
+inline TwoWire Wire;
@@ -0,0 +1,1735 @@
+// Host benchmark of the I2C traffic generated by the TDA7419 driver.
+// Build and run with: make -C extras/host run
+
+#include <Wire.h>
+#include <tda7419.hpp>
+#include <tda7419Coalescer.hpp>
+#include <tda7419Fader.hpp>
+#include <tda7419GainPlanner.hpp>
+#include <tda7419Loudness.hpp>
+#include <tda7419Group.hpp>
+#include <tda7419Presets.hpp>
+#include <tda7419Protocol.hpp>
+#include <tda7419SourceSwitcher.hpp>
+#include <tda7419State.hpp>
+#include <tda7419Spectrum.hpp>
+
+#include "FilePresetStore.h"
+#include "ResponseModel.h"
+#include "SpectrumSim.h"
+
+#include <bitStorage.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+    using Device = TDA7419::TDA7419;
+
+    struct Scenario {
+        const char* name;
+        void (*apply)(Device& dev);
+    };
+
+    const Scenario setterScenarios[] = {
+        { "setMainSource",            [](Device& d) { d.setMainSource(TDA7419::InputSource::SE1); } },
+        { "setInputGain",             [](Device& d) { d.setInputGain(8); } },
+        { "setRearSpeakerSource",     [](Device& d) { d.setRearSpeakerSource(TDA7419::RearSpeakerSource::secondSource); } },
+        { "setSecondSource",          [](Device& d) { d.setSecondSource(TDA7419::InputSource::SE3); } },
+        { "setSecondSourceInputGain", [](Device& d) { d.setSecondSourceInputGain(4); } },
+        { "setAutoZero",              [](Device& d) { d.setAutoZero(true); } },
+        { "setLoudnessAttenuation",   [](Device& d) { d.setLoudnessAttenuation(5); } },
+        { "setLoudnessCenterFreq",    [](Device& d) { d.setLoudnessCenterFreq(TDA7419::LoudnessCenterFreq::Hz800); } },
+        { "setLoudnessHighBoost",     [](Device& d) { d.setLoudnessHighBoost(true); } },
+        { "setLoudnessSoftStep",      [](Device& d) { d.setLoudnessSoftStep(true); } },
+        { "setSoftMute",              [](Device& d) { d.setSoftMute(false); } },
+        { "setMutePinEnable",         [](Device& d) { d.setMutePinEnable(false); } },
+        { "setSoftMuteTime",          [](Device& d) { d.setSoftMuteTime(TDA7419::SoftMuteTime::Ms123); } },
+        { "setSoftStepTime",          [](Device& d) { d.setSoftStepTime(TDA7419::SoftStepTime::Us5120); } },
+        { "setClockFastMode",         [](Device& d) { d.setClockFastMode(false); } },
+        { "setMasterVolumeSoftStep",  [](Device& d) { d.setMasterVolumeSoftStep(true); } },
+        { "setMasterVolume",          [](Device& d) { d.setMasterVolume(-20); } },
+        { "setTrebleLevel",           [](Device& d) { d.setTrebleLevel(3); } },
+        { "setTrebleCenterFreq",      [](Device& d) { d.setTrebleCenterFreq(TDA7419::TrebleCenterFreq::KHz15); } },
+        { "setTrebleReferenceInternal",[](Device& d) { d.setTrebleReferenceInternal(false); } },
+        { "setMiddleSoftStep",        [](Device& d) { d.setMiddleSoftStep(true); } },
+        { "setMiddleLevel",           [](Device& d) { d.setMiddleLevel(-4); } },
+        { "setMiddleQFactor",         [](Device& d) { d.setMiddleQFactor(TDA7419::MiddleQFactor::Q1); } },
+        { "setBassSoftStep",          [](Device& d) { d.setBassSoftStep(true); } },
+        { "setBassLevel",             [](Device& d) { d.setBassLevel(6); } },
+        { "setBassQFactor",           [](Device& d) { d.setBassQFactor(TDA7419::BassQFactor::Q1_5); } },
+        { "setSmoothingFilter",       [](Device& d) { d.setSmoothingFilter(false); } },
+        { "setBassDcMode",            [](Device& d) { d.setBassDcMode(false); } },
+        { "setBassCenterFreq",        [](Device& d) { d.setBassCenterFreq(TDA7419::BassCenterFreq::Hz200); } },
+        { "setMiddleCenterFreq",      [](Device& d) { d.setMiddleCenterFreq(TDA7419::MiddleCenterFreq::Hz1500); } },
+        { "setSubCutoffFreq",         [](Device& d) { d.setSubCutoffFreq(TDA7419::SubCutoffFreq::Hz120); } },
+        { "setMixingGainEffect",      [](Device& d) { d.setMixingGainEffect(TDA7419::MixingGainEffect::dB10); } },
+        { "setSubwooferEnable",       [](Device& d) { d.setSubwooferEnable(true); } },
+        { "setMixingEnable",          [](Device& d) { d.setMixingEnable(false); } },
+        { "setMixToRightFront",       [](Device& d) { d.setMixToRightFront(false); } },
+        { "setMixToLeftFront",        [](Device& d) { d.setMixToLeftFront(false); } },
+        { "setSpeakerSoftStep",       [](Device& d) { d.setSpeakerSoftStep(TDA7419::SpeakerChannel::LeftRear, true); } },
+        { "setSpeakerVolume",         [](Device& d) { d.setSpeakerVolume(TDA7419::SpeakerChannel::RightFront, -10); } },
+        { "setMixingChannelSoftStep", [](Device& d) { d.setMixingChannelSoftStep(true); } },
+        { "setMixingChannelVolume",   [](Device& d) { d.setMixingChannelVolume(-30); } },
+        { "setSubwooferSoftStep",     [](Device& d) { d.setSubwooferSoftStep(true); } },
+        { "setSubwooferVolume",       [](Device& d) { d.setSubwooferVolume(5); } },
+        { "setSpectrumCouplingMode",  [](Device& d) { d.setSpectrumCouplingMode(TDA7419::SpectrumCouplingMode::DC_w_HPF); } },
+        { "setExternalClock",         [](Device& d) { d.setExternalClock(true); } },
+        { "setSpectrumReset",         [](Device& d) { d.setSpectrumReset(false); } },
+        { "setSpectrumRun",           [](Device& d) { d.setSpectrumRun(false); } },
+        { "setSpectrumSource",        [](Device& d) { d.setSpectrumSource(TDA7419::SpectrumSource::Bass); } },
+        { "setSpectrumAutoReset",     [](Device& d) { d.setSpectrumAutoReset(true); } },
+        { "setSpectrumFilterQ",       [](Device& d) { d.setSpectrumFilterQ(TDA7419::SpectrumFilterQ::Q1_75); } },
+        { "all speakers + subwoofer", [](Device& d) {
+            d.setSpeakerVolume(TDA7419::SpeakerChannel::LeftFront, -6);
+            d.setSpeakerVolume(TDA7419::SpeakerChannel::RightFront, -6);
+            d.setSpeakerVolume(TDA7419::SpeakerChannel::LeftRear, -6);
+            d.setSpeakerVolume(TDA7419::SpeakerChannel::RightRear, -6);
+            d.setMixingChannelVolume(-6);
+            d.setSubwooferVolume(-6);
+        } },
+        { "preset (UpdateGuard)",     [](Device& d) {
+            TDA7419::UpdateGuard update(d);
+            d.setBassLevel(4);
+            d.setBassQFactor(TDA7419::BassQFactor::Q1_25);
+            d.setBassCenterFreq(TDA7419::BassCenterFreq::Hz80);
+            d.setMiddleLevel(-2);
+            d.setTrebleLevel(3);
+            d.setLoudnessAttenuation(6);
+            d.setMasterVolume(-12);
+            d.setSubwooferVolume(-3);
+        } },
+    };
+
+    constexpr uint32_t busClocks[] = { 100000, 400000, 1000000 };
+
+    void printHeader(const char* title) {
+        std::printf("\n%s\n", title);
+        std::printf("%-28s %6s %6s %12s %12s %12s\n", "operation", "trans", "bytes", "us@100kHz", "us@400kHz", "us@1MHz");
+    }
+
+    void printRow(const char* name) {
+        std::printf("%-28s %6zu %6zu", name, Wire.transactions().size(), Wire.totalBytes());
+        for (uint32_t hz : busClocks) {
+            std::printf(" %12.1f", Wire.totalNanosAt(hz) / 1000.0);
+        }
+        std::printf("\n");
+    }
+
+    // Device in a known, fully flushed state with an empty bus log
+    void prepare(Device& dev) {
+        dev.begin();
+        Wire.clearLog();
+    }
+
+    // Apply the logged traffic to an image of the chip registers
+    void applyTraffic(TDA7419::RegisterImage& chip) {
+        for (const I2CTransaction& t : Wire.transactions()) {
+            if (t.result != 0 || t.data.empty()) {
+                continue;
+            }
+            uint8_t reg = t.data[0] & 0x1F;
+            const bool autoIncrement = (t.data[0] & TDA7419::SUBADDR_AUTO_INCREMENT_BIT) != 0;
+            for (size_t i = 1; i < t.data.size() && reg < TDA7419::REGISTER_COUNT; ++i) {
+                chip[reg] = t.data[i];
+                if (autoIncrement) {
+                    ++reg;
+                }
+            }
+        }
+    }
+
+    void benchSetters() {
+        printHeader("Setter + sendChangedRegisters()");
+        for (const Scenario& s : setterScenarios) {
+            Device dev;
+            prepare(dev);
+            s.apply(dev);
+            dev.sendChangedRegisters();
+            printRow(s.name);
+        }
+    }
+
+    void benchFullWrites() {
+        printHeader("Full register writes");
+        {
+            Device dev;
+            Wire.clearLog();
+            dev.begin();
+            printRow("begin");
+        }
+        {
+            Device dev;
+            prepare(dev);
+            dev.sendAllRegisters();
+            printRow("sendAllRegisters");
+        }
+        {
+            Device dev;
+            prepare(dev);
+            dev.sendChangedRegisters();
+            printRow("sendChangedRegisters (idle)");
+        }
+    }
+
+    // Update transactions: nothing reaches the chip before the outermost commit(), and
+    // abort() leaves shadow and chip at the committed image
+    bool benchTransactions() {
+        std::printf("\nUpdate transactions\n");
+
+        Device dev;
+        Wire.clearLog();
+        dev.begin();
+        TDA7419::RegisterImage chip{};
+        applyTraffic(chip);
+        Wire.clearLog();
+        TDA7419::RegisterImage committed;
+        dev.getRegisterImage(committed);
+
+        // every way of flushing is tried inside the transaction that is then aborted
+        dev.beginUpdate();
+        dev.setMasterVolume(-30);
+        dev.setBassLevel(7);
+        dev.setMainSource(TDA7419::InputSource::SE2);
+        dev.sendRegister(TDA7419::REG_MASTER_VOLUME);
+        dev.sendRegisterRange(TDA7419::REG_TREBLE_FILTER, 3);
+        dev.sendAllRegisters();
+        dev.sendChangedRegisters();
+        dev.poll(100000);
+        const size_t sentInside = Wire.transactions().size();
+        dev.abort();
+        dev.sendChangedRegisters();
+        applyTraffic(chip);
+
+        TDA7419::RegisterImage shadow;
+        dev.getRegisterImage(shadow);
+        const bool abortOk = sentInside == 0 && shadow == committed && chip == committed && !dev.isFlushPending();
+        std::printf("abort: %zu transactions inside, shadow %s, chip %s\n", sentInside,
+            shadow == committed ? "restored" : "DIFFERS", chip == committed ? "restored" : "DIFFERS");
+
+        // nested: the inner commit sends nothing, the outer one every change
+        Wire.clearLog();
+        dev.beginUpdate();
+        dev.setMasterVolume(-12);
+        dev.beginUpdate();
+        dev.setTrebleLevel(5);
+        dev.sendRegister(TDA7419::REG_TREBLE_FILTER);
+        dev.commit();
+        const size_t sentInner = Wire.transactions().size();
+        dev.setSubwooferVolume(-3);
+        dev.commit();
+        const size_t sentOuter = Wire.transactions().size() - sentInner;
+        applyTraffic(chip);
+        dev.getRegisterImage(shadow);
+        const bool nestedOk = sentInner == 0 && sentOuter > 0 && chip == shadow && !dev.isFlushPending();
+        std::printf("nested commit: %zu transactions at the inner commit, %zu at the outer, chip %s\n",
+            sentInner, sentOuter, chip == shadow ? "= shadow" : "DIFFERS");
+
+        const bool ok = abortOk && nestedOk;
+        std::printf("transaction check: %s\n", ok ? "ok" : "FAIL");
+        return ok;
+    }
+
+    void benchPoll() {
+        std::printf("\npoll(budget) draining a full register refresh @100kHz\n");
+        std::printf("%-12s %6s %6s %16s\n", "budget us", "calls", "trans", "max us per call");
+        for (uint32_t budget : { 150u, 300u, 600u, 2000u }) {
+            Device dev;
+            prepare(dev);
+            dev.queueAllRegisters();
+
+            uint32_t calls = 0;
+            uint64_t maxNs = 0;
+            while (dev.isFlushPending() && calls < 100) {
+                const uint64_t before = hostClock::nanos;
+                dev.poll(budget);
+                maxNs = std::max<uint64_t>(maxNs, hostClock::nanos - before);
+                ++calls;
+            }
+            std::printf("%-12u %6u %6zu %16.1f\n", budget, calls, Wire.transactions().size(), maxNs / 1000.0);
+        }
+    }
+
+    // Background scrubbing: bus share, cycles and time to heal a brown-out
+    bool benchScrub() {
+        std::printf("\nScrubbing: 10 s of poll(1000) every 1 ms @100kHz, volume change every 100 ms, brown-out at 5 s\n");
+        std::printf("%-8s %8s %8s %12s %12s %16s %16s\n", "budget", "slices", "cycles", "scrub share", "user share", "max user lag us", "healed after ms");
+
+        bool ok = true;
+        for (uint16_t permille : { 0, 10, 20, 50 }) {
+            Device dev;
+            prepare(dev);
+            hostClock::reset();
+            dev.setScrubBudget(permille);
+
+            constexpr uint64_t runNs = 10000000000ULL;
+            constexpr uint64_t brownoutNs = runNs / 2;
+            uint64_t maxLagNs = 0;
+            for (uint64_t tick = 0; tick < runNs; tick += 1000000) {
+                hostClock::nanos = tick;
+                const bool change = tick % 100000000 == 0;
+                if (change) {
+                    dev.setMasterVolume(static_cast<int8_t>(-static_cast<int>(tick / 100000000 % 40)));
+                }
+                dev.poll(1000);
+                if (change) {
+                    // the change is on the chip when its write ends, whatever the scrubber does after it
+                    for (auto t = Wire.transactions().rbegin(); t != Wire.transactions().rend(); ++t) {
+                        if (t->data.size() == 2 && (t->data[0] & 0x1F) == TDA7419::REG_MASTER_VOLUME) {
+                            maxLagNs = std::max<uint64_t>(maxLagNs, t->startNs + t->durationNs - tick);
+                            break;
+                        }
+                    }
+                }
+            }
+
+            // user writes are the single master volume register; everything else is scrubbing
+            uint64_t userNs = 0;
+            uint64_t scrubNs = 0;
+            uint32_t slices = 0;
+            uint32_t covered = 0;
+            uint64_t healedNs = 0;
+            bool autoZeroKept = true;
+            for (const I2CTransaction& t : Wire.transactions()) {
+                const uint8_t first = t.data[0] & 0x1F;
+                const uint8_t count = static_cast<uint8_t>(t.data.size() - 1);
+                if (count == 1 && first == TDA7419::REG_MASTER_VOLUME) {
+                    userNs += t.durationNs;
+                }
+                else {
+                    scrubNs += t.durationNs;
+                    ++slices;
+                    // rewriting the source without AutoZero remain would mute the output every cycle
+                    if (first == TDA7419::REG_MAIN_SOURCE && (t.data[0] & TDA7419::SUBADDR_AUTOZERO_REMAIN_BIT) == 0) {
+                        autoZeroKept = false;
+                    }
+                }
+
+                // first time after the brown-out by which every register was rewritten
+                if (t.startNs >= brownoutNs && covered != TDA7419::ALL_REGISTERS_MASK) {
+                    covered |= TDA7419::registerRangeMask(first, count);
+                    healedNs = t.startNs + t.durationNs - brownoutNs;
+                }
+            }
+
+            char name[8];
+            std::snprintf(name, sizeof(name), "%u.%u%%", permille / 10, permille % 10);
+            char healed[16];
+            if (covered == TDA7419::ALL_REGISTERS_MASK) {
+                std::snprintf(healed, sizeof(healed), "%.1f", healedNs / 1e6);
+            }
+            else {
+                std::snprintf(healed, sizeof(healed), "never");
+            }
+            std::printf("%-8s %8u %8u %11.2f%% %11.2f%% %16.1f %16s\n", name, slices, dev.getScrubCycles(),
+                100.0 * scrubNs / runNs, 100.0 * userNs / runNs, maxLagNs / 1000.0, healed);
+            ok = ok && autoZeroKept && (permille == 0 || covered == TDA7419::ALL_REGISTERS_MASK);
+        }
+
+        std::printf("scrub check: %s (register 0 slices keep AutoZero remain)\n", ok ? "ok" : "FAIL");
+        return ok;
+    }
+
+    // Encoder input: every detent is a setter call, flushed under different policies
+    struct KnobEvent {
+        uint64_t ns;
+        uint8_t reg;
+    };
+
+    bool covers(const I2CTransaction& t, uint8_t reg) {
+        const uint8_t first = t.data[0] & 0x1F;
+        return reg >= first && reg < first + t.data.size() - 1;
+    }
+
+    bool benchCoalescer() {
+        constexpr uint32_t loopMicros = 1000;
+        constexpr uint64_t runNs = 2000000000ULL;
+        std::printf("\nEncoder input for 2 s: master at 2 kHz + bass at 500 Hz, 300 ms spins, loop every %u us @100kHz\n", loopMicros);
+        std::printf("%-24s %7s %6s %10s %21s %21s %6s\n", "flush policy", "events", "trans", "bus share",
+            "master lag/bound us", "bass lag/bound us", "final");
+
+        enum class Policy { EveryEvent, EveryLoop, Coalesced };
+        const struct { const char* name; Policy policy; uint16_t volumeRate; uint16_t toneRate; } cases[] = {
+            { "every event", Policy::EveryEvent, 0, 0 },
+            { "every loop", Policy::EveryLoop, 0, 0 },
+            { "coalesced 50/s, 25/s", Policy::Coalesced, 50, 25 },
+            { "coalesced 20/s, 10/s", Policy::Coalesced, 20, 10 },
+        };
+
+        bool withinBound = true;
+        for (const auto& c : cases) {
+            Device dev;
+            prepare(dev);
+            hostClock::reset();
+            TDA7419::FlushCoalescer coalescer(dev);
+            coalescer.setGroupRate(0, TDA7419::registerRangeMask(TDA7419::REG_MASTER_VOLUME, 1) |
+                TDA7419::registerRangeMask(TDA7419::REG_SPEAKER_LF_LEVEL, 4), c.volumeRate);
+            coalescer.setGroupRate(1, TDA7419::registerRangeMask(TDA7419::REG_TREBLE_FILTER, 3), c.toneRate);
+
+            std::vector<KnobEvent> events;
+            int volume = 0;
+            int bass = 0;
+            for (uint64_t tick = 0; tick < runNs; tick += 100000) {
+                hostClock::nanos = std::max(hostClock::nanos, tick);
+                const bool spinning = tick % 500000000 < 300000000;
+                if (spinning && tick % 500000 == 0) {
+                    volume = (volume + 1) % 60;
+                    dev.setMasterVolume(static_cast<int8_t>(-volume));
+                    events.push_back({ hostClock::nanos, TDA7419::REG_MASTER_VOLUME });
+                    if (c.policy == Policy::EveryEvent) {
+                        dev.sendChangedRegisters();
+                    }
+                }
+                if (spinning && tick % 2000000 == 0) {
+                    bass = (bass + 1) % 31;
+                    dev.setBassLevel(static_cast<int8_t>(bass - 15));
+                    events.push_back({ hostClock::nanos, TDA7419::REG_BASS_FILTER });
+                    if (c.policy == Policy::EveryEvent) {
+                        dev.sendChangedRegisters();
+                    }
+                }
+                if (tick % (loopMicros * 1000ULL) == 0) {
+                    if (c.policy == Policy::EveryLoop) {
+                        dev.sendChangedRegisters();
+                    }
+                    else if (c.policy == Policy::Coalesced) {
+                        coalescer.update();
+                    }
+                }
+            }
+
+            // latency of a detent: until the end of the first write of its register that starts after it
+            const std::vector<I2CTransaction>& log = Wire.transactions();
+            uint64_t maxLatencyNs[TDA7419::REGISTER_COUNT] = {};
+            for (const KnobEvent& e : events) {
+                auto t = std::lower_bound(log.begin(), log.end(), e.ns,
+                    [](const I2CTransaction& x, uint64_t ns) { return x.startNs < ns; });
+                while (t != log.end() && !covers(*t, e.reg)) {
+                    ++t;
+                }
+                const uint64_t boundNs = coalescer.getLatencyBoundMicros(e.reg, loopMicros) * 1000ULL;
+                const uint64_t latencyNs = t == log.end() ? UINT64_MAX : t->startNs + t->durationNs - e.ns;
+                withinBound = withinBound && latencyNs <= boundNs;
+                maxLatencyNs[e.reg] = std::max(maxLatencyNs[e.reg], latencyNs);
+            }
+
+            // last writer wins: the chip ends up with the last value of every knob
+            bool final = dev.getDirtyMask() == 0;
+            for (uint8_t reg : { TDA7419::REG_MASTER_VOLUME, TDA7419::REG_BASS_FILTER }) {
+                auto t = std::find_if(log.rbegin(), log.rend(), [reg](const I2CTransaction& x) { return covers(x, reg); });
+                final = final && t != log.rend() && t->data[1 + reg - (t->data[0] & 0x1F)] == dev.getRegisterValue(reg);
+            }
+
+            std::printf("%-24s %7zu %6zu %9.2f%%", c.name, events.size(), log.size(), 100.0 * Wire.totalNanos() / runNs);
+            for (uint8_t reg : { TDA7419::REG_MASTER_VOLUME, TDA7419::REG_BASS_FILTER }) {
+                std::printf(" %11.1f / %7u", maxLatencyNs[reg] / 1000.0, coalescer.getLatencyBoundMicros(reg, loopMicros));
+            }
+            std::printf(" %6s\n", final ? "ok" : "STALE");
+        }
+
+        // the flush term alone must cover the costliest plan: everything pending, split by priority
+        Device dev;
+        prepare(dev);
+        TDA7419::FlushCoalescer ungrouped(dev);
+        dev.queueAllRegisters();
+        dev.sendChangedRegisters();
+        const uint64_t flushNs = Wire.totalNanos();
+        const uint32_t flushBound = ungrouped.getLatencyBoundMicros(TDA7419::REG_MASTER_VOLUME, 0);
+        const bool flushCovered = flushNs <= flushBound * 1000ULL;
+        std::printf("full flush in %zu bursts: %.1f us, bound %u us\n", Wire.transactions().size(), flushNs / 1000.0, flushBound);
+
+        if (!withinBound || !flushCovered) {
+            std::printf("latency bound VIOLATED\n");
+        }
+        return withinBound && flushCovered;
+    }
+
+    // Flush ordering: a preset touching tone, spectrum and volume registers plus an unmute
+    bool benchPriority() {
+        std::printf("\nPreset (loudness, tone, mixing, spectrum) + volumes + unmute, setter to bus @100kHz\n");
+        std::printf("%-28s %-9s %6s %18s %18s\n", "flush", "order", "trans", "urgent worst us", "deferrable worst us");
+
+        auto preset = [](Device& d) {
+            d.setLoudnessAttenuation(4);
+            d.setTrebleLevel(3);
+            d.setMiddleLevel(-2);
+            d.setBassLevel(5);
+            d.setSubCutoffFreq(TDA7419::SubCutoffFreq::Hz120);
+            d.setMixingEnable(false);
+            d.setSpectrumFilterQ(TDA7419::SpectrumFilterQ::Q1_75);
+            d.setMasterVolume(-12);
+            for (uint8_t ch = 0; ch < TDA7419::SPEAKER_CHANNEL_COUNT; ++ch) {
+                d.setSpeakerVolume(static_cast<TDA7419::SpeakerChannel>(ch), -2);
+            }
+            d.setSubwooferVolume(3);
+            d.setSoftMute(true);
+        };
+
+        for (uint32_t budget : { 0u, 300u }) {
+            for (bool prioritized : { false, true }) {
+                Device dev;
+                prepare(dev);
+                dev.setSoftMute(false);
+                dev.sendChangedRegisters();
+                Wire.clearLog();
+                hostClock::reset();
+                if (!prioritized) {
+                    // a single class flushes in register index order
+                    dev.setUrgentRegisters(TDA7419::ALL_REGISTERS_MASK);
+                }
+
+                preset(dev);
+                const uint32_t changed = dev.getDirtyMask();
+                if (budget == 0) {
+                    dev.sendChangedRegisters();
+                }
+                else {
+                    for (uint64_t tick = 0; dev.isFlushPending(); tick += 1000000) {
+                        hostClock::nanos = std::max(hostClock::nanos, tick);
+                        dev.poll(budget);
+                    }
+                }
+
+                // every setter ran at t = 0, so a register's latency is the end of its first write
+                uint64_t worstNs[2] = {};
+                for (uint32_t pending = changed; pending != 0; pending &= pending - 1) {
+                    const uint8_t reg = TDA7419::lowestSetBit(pending);
+                    for (const I2CTransaction& t : Wire.transactions()) {
+                        if (covers(t, reg)) {
+                            const bool urgent = (TDA7419::DEFAULT_URGENT_REGISTERS_MASK >> reg) & 1;
+                            worstNs[urgent ? 0 : 1] = std::max(worstNs[urgent ? 0 : 1], t.startNs + t.durationNs);
+                            break;
+                        }
+                    }
+                }
+
+                char flush[32];
+                if (budget == 0) {
+                    std::snprintf(flush, sizeof(flush), "sendChangedRegisters()");
+                }
+                else {
+                    std::snprintf(flush, sizeof(flush), "poll(%u) every 1 ms", budget);
+                }
+                std::printf("%-28s %-9s %6zu %18.1f %18.1f\n", flush, prioritized ? "priority" : "index",
+                    Wire.transactions().size(), worstNs[0] / 1000.0, worstNs[1] / 1000.0);
+            }
+        }
+
+        // with a source change in the preset only the burst writing register 0 has AutoZero remain
+        auto autoZeroBursts = [](uint8_t& startingAtZero) {
+            uint8_t marked = 0;
+            startingAtZero = 0;
+            for (const I2CTransaction& t : Wire.transactions()) {
+                if (!t.data.empty() && (t.data[0] & TDA7419::SUBADDR_AUTOZERO_REMAIN_BIT) != 0) {
+                    ++marked;
+                    if ((t.data[0] & 0x1F) == TDA7419::REG_MAIN_SOURCE) {
+                        ++startingAtZero;
+                    }
+                }
+            }
+            return marked;
+        };
+
+        Device dev;
+        prepare(dev);
+        preset(dev);
+        dev.setMainSource(TDA7419::InputSource::SE3);
+        Wire.clearLog();
+        dev.sendChangedRegisters();
+        uint8_t atZero = 0;
+        const size_t bursts = Wire.transactions().size();
+        const uint8_t marked = autoZeroBursts(atZero);
+
+        TDA7419::RegisterImage image;
+        dev.getRegisterImage(image);
+        uint32_t sent = 0;
+        Wire.clearLog();
+        dev.sendImageRegisters(image, TDA7419::ALL_REGISTERS_MASK & ~TDA7419::registerRangeMask(TDA7419::REG_SOFT_MUTE_CONTROL, 1), true, sent);
+        uint8_t imageAtZero = 0;
+        const uint8_t imageMarked = autoZeroBursts(imageAtZero);
+
+        const bool ok = bursts > 1 && marked == 1 && atZero == 1 && Wire.transactions().size() > 1 &&
+            imageMarked == 1 && imageAtZero == 1;
+        std::printf("source change in %zu bursts: %u with AutoZero remain (register 0 burst: %s); check: %s\n",
+            bursts, marked, atZero == 1 ? "yes" : "no", ok ? "ok" : "FAIL");
+        return ok;
+    }
+
+    // Source switch: mute, switch, AutoZero, unmute; blocking delays vs the sequencer
+    bool benchSourceSwitch() {
+        std::printf("\nSource switch SE1 -> SE2 with AutoZero %u us, loop every 1 ms @100kHz\n", TDA7419::DEFAULT_AUTOZERO_MICROS);
+        std::printf("%-12s %-10s %6s %6s %9s %14s %16s %18s\n", "method", "soft-mute", "trans", "bytes", "done ms",
+            "max stall us", "mute->switch us", "switch->unmute us");
+
+        const struct { const char* name; TDA7419::SoftMuteTime time; } times[] = {
+            { "0.48 ms", TDA7419::SoftMuteTime::Ms048 },
+            { "0.96 ms", TDA7419::SoftMuteTime::Ms096 },
+            { "123 ms", TDA7419::SoftMuteTime::Ms123 },
+        };
+
+        bool ok = true;
+        for (const auto& time : times) {
+            for (bool sequenced : { false, true }) {
+                Device dev;
+                prepare(dev);
+                dev.setSoftMuteTime(time.time);
+                dev.setSoftMute(true);
+                dev.setMainSource(TDA7419::InputSource::SE1);
+                dev.sendChangedRegisters();
+                Wire.clearLog();
+                hostClock::reset();
+
+                TDA7419::SourceSwitcher switcher(dev);
+                uint64_t stallNs = 0;
+                uint64_t doneNs = 0;
+                if (!sequenced) {
+                    // what a sketch does today
+                    dev.setSoftMute(false);
+                    dev.sendChangedRegisters();
+                    delayMicroseconds(switcher.getMuteMicros());
+                    dev.setMainSource(TDA7419::InputSource::SE2);
+                    dev.setInputGain(4);
+                    dev.sendChangedRegisters();
+                    delayMicroseconds(switcher.getAutoZeroMicros());
+                    dev.setSoftMute(true);
+                    dev.sendChangedRegisters();
+                    delayMicroseconds(switcher.getMuteMicros());
+                    stallNs = doneNs = hostClock::nanos;
+                }
+                std::vector<TDA7419::SourceSwitchState> states;
+                if (sequenced) {
+                    bool done = switcher.switchSource(TDA7419::InputSource::SE2, 4);
+                    states.push_back(switcher.getState());
+                    stallNs = hostClock::nanos;
+                    for (uint64_t tick = 1000000; !done; tick += 1000000) {
+                        hostClock::nanos = std::max(hostClock::nanos, tick);
+                        const uint64_t before = hostClock::nanos;
+                        done = switcher.update();
+                        if (switcher.getState() != states.back()) {
+                            states.push_back(switcher.getState());
+                        }
+                        stallNs = std::max(stallNs, hostClock::nanos - before);
+                        doneNs = hostClock::nanos;
+                    }
+                }
+
+                // mute, source, unmute: the gaps the chip sees between the three writes
+                const std::vector<I2CTransaction>& log = Wire.transactions();
+                double muteGap = 0;
+                double zeroGap = 0;
+                if (log.size() == 3) {
+                    muteGap = (log[1].startNs - log[0].startNs - log[0].durationNs) / 1000.0;
+                    zeroGap = (log[2].startNs - log[1].startNs - log[1].durationNs) / 1000.0;
+                }
+                std::printf("%-12s %-10s %6zu %6zu %9.2f %14.1f %16.1f %18.1f\n", sequenced ? "sequencer" : "blocking",
+                    time.name, log.size(), Wire.totalBytes(), doneNs / 1e6, stallNs / 1000.0, muteGap, zeroGap);
+
+                // the sequencer must go through every state in order, write register 2, 0, 2 and
+                // wait at least each ramp, but not a loop tick longer
+                if (sequenced) {
+                    const std::vector<TDA7419::SourceSwitchState> expected = { TDA7419::SourceSwitchState::Muting,
+                        TDA7419::SourceSwitchState::Settling, TDA7419::SourceSwitchState::Unmuting, TDA7419::SourceSwitchState::Idle };
+                    const double muteUs = switcher.getMuteMicros();
+                    const double zeroUs = switcher.getAutoZeroMicros();
+                    const bool order = log.size() == 3 && (log[0].data[0] & 0x1F) == TDA7419::REG_SOFT_MUTE_CONTROL &&
+                        (log[1].data[0] & 0x1F) == TDA7419::REG_MAIN_SOURCE && (log[2].data[0] & 0x1F) == TDA7419::REG_SOFT_MUTE_CONTROL;
+                    const bool waits = muteGap >= muteUs && muteGap < muteUs + 1000 && zeroGap >= zeroUs && zeroGap < zeroUs + 1000;
+                    ok = ok && states == expected && order && waits &&
+                        dev.getMainSource() == TDA7419::InputSource::SE2 && dev.getInputGain() == 4 && dev.getSoftMute();
+                }
+            }
+        }
+
+        // a muted device stays muted: only the source is written
+        Device dev;
+        prepare(dev);
+        dev.setMainSource(TDA7419::InputSource::SE1);
+        dev.setSoftMute(false);
+        dev.sendChangedRegisters();
+        Wire.clearLog();
+        TDA7419::SourceSwitcher switcher(dev);
+        bool done = switcher.switchSource(TDA7419::InputSource::SE2, 4);
+        for (uint64_t tick = hostClock::nanos + 1000000; !done; tick += 1000000) {
+            hostClock::nanos = std::max(hostClock::nanos, tick);
+            done = switcher.update();
+        }
+        const bool mutedOk = Wire.transactions().size() == 1 &&
+            (Wire.transactions()[0].data[0] & 0x1F) == TDA7419::REG_MAIN_SOURCE && !dev.getSoftMute();
+
+        // a publisher acknowledging an older source leaves the change pending with its AutoZero
+        // remain bit; acknowledging the current source consumes both
+        auto sourceWrite = [](const std::vector<I2CTransaction>& log) {
+            return std::find_if(log.begin(), log.end(), [](const I2CTransaction& t) { return covers(t, TDA7419::REG_MAIN_SOURCE); });
+        };
+        Device published;
+        prepare(published);
+        TDA7419::RegisterImage image;
+        published.setMainSource(TDA7419::InputSource::SE3);
+        published.getRegisterImage(image);
+        published.setMainSource(TDA7419::InputSource::SE1);
+        published.acknowledgeImage(image, TDA7419::registerRangeMask(TDA7419::REG_MAIN_SOURCE, 1));
+        published.sendChangedRegisters();
+        auto write = sourceWrite(Wire.transactions());
+        const bool staleKept = write != Wire.transactions().end() && (write->data[0] & TDA7419::SUBADDR_AUTOZERO_REMAIN_BIT) != 0;
+
+        published.setMainSource(TDA7419::InputSource::SE3);
+        published.getRegisterImage(image);
+        published.acknowledgeImage(image, TDA7419::registerRangeMask(TDA7419::REG_MAIN_SOURCE, 1));
+        const bool acknowledged = !published.isFlushPending();
+        Wire.clearLog();
+        published.queueAllRegisters();
+        published.sendChangedRegisters();
+        write = sourceWrite(Wire.transactions());
+        const bool consumed = write != Wire.transactions().end() && (write->data[0] & TDA7419::SUBADDR_AUTOZERO_REMAIN_BIT) == 0;
+
+        ok = ok && mutedOk && staleKept && acknowledged && consumed;
+        std::printf("acknowledged source: stale %s AutoZero remain, current %s it; source switch check: %s\n",
+            staleKept ? "keeps" : "LOSES", acknowledged && consumed ? "consumes" : "does NOT consume", ok ? "ok" : "FAIL");
+        return ok;
+    }
+
+    // Byte sink for the state writers
+    struct ByteSink {
+        std::vector<uint8_t> bytes;
+        size_t write(uint8_t byte) {
+            bytes.push_back(byte);
+            return 1;
+        }
+    };
+
+    // State import/export: full state in each format, parsed byte by byte
+    bool benchState() {
+        Device source;
+        prepare(source);
+        source.setMainSource(TDA7419::InputSource::SE2);
+        source.setInputGain(6);
+        source.setLoudnessAttenuation(3);
+        source.setLoudnessHighBoost(true);
+        source.setMasterVolume(-23);
+        source.setBassLevel(7);
+        source.setMiddleLevel(-4);
+        source.setTrebleLevel(2);
+        source.setMixingGainEffect(TDA7419::MixingGainEffect::dB14);
+        source.setSpeakerVolume(TDA7419::SpeakerChannel::LeftRear, -9);
+        source.setSubwooferVolume(4);
+        source.setSpectrumFilterQ(TDA7419::SpectrumFilterQ::Q1_75);
+        TDA7419::RegisterImage expected;
+        source.getRegisterImage(expected);
+
+        std::printf("\nState import, %u parameters, parsed byte by byte (StateParser: %zu bytes RAM, no heap)\n",
+            TDA7419::PARAM_COUNT, sizeof(TDA7419::StateParser));
+        std::printf("%-10s %6s %8s %8s %6s %10s %12s %10s\n", "format", "bytes", "applied", "rejected", "bursts", "image", "us/message", "MB/s");
+
+        const struct { const char* name; int format; } formats[] = {
+            { "binary", -1 },
+            { "key=value", static_cast<int>(TDA7419::StateTextFormat::KeyValue) },
+            { "json", static_cast<int>(TDA7419::StateTextFormat::Json) },
+        };
+        bool ok = true;
+        for (const auto& f : formats) {
+            ByteSink sink;
+            if (f.format < 0) {
+                TDA7419::writeStateBinary(source, sink);
+            }
+            else {
+                TDA7419::writeStateText(source, sink, static_cast<TDA7419::StateTextFormat>(f.format));
+            }
+
+            // first import into a device at power-on defaults: one coalesced flush
+            Device dev;
+            prepare(dev);
+            TDA7419::StateParser parser(dev);
+            parser.begin();
+            for (uint8_t byte : sink.bytes) {
+                parser.feed(byte);
+            }
+            parser.end();
+            const size_t flushes = Wire.transactions().size();
+            TDA7419::RegisterImage image;
+            dev.getRegisterImage(image);
+
+            // throughput: the state is already applied, so only parsing and setters run
+            constexpr int iterations = 20000;
+            const auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < iterations; ++i) {
+                parser.begin();
+                for (uint8_t byte : sink.bytes) {
+                    parser.feed(byte);
+                }
+                parser.end();
+            }
+            const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+            std::printf("%-10s %6zu %8u %8u %6zu %10s %12.2f %10.1f\n", f.name, sink.bytes.size(), parser.getApplied(),
+                parser.getRejected(), flushes, image == expected ? "match" : "DIFFERS", ns / 1000.0, sink.bytes.size() / ns * 1000.0);
+            ok = ok && image == expected && parser.getRejected() == 0 && flushes > 0;
+        }
+
+        // runs reaching past the last parameter: the overhang is rejected and nothing wraps to id 0
+        {
+            Device dev;
+            prepare(dev);
+            TDA7419::RegisterImage before;
+            dev.getRegisterImage(before);
+            TDA7419::StateParser parser(dev);
+            const uint8_t lastId = TDA7419::PARAM_COUNT - 1;
+            const int8_t lastValue = static_cast<int8_t>(TDA7419::getParam(dev, lastId));
+            const uint8_t message[] = { TDA7419::STATE_BINARY_MAGIC,
+                lastId, 3, static_cast<uint8_t>(lastValue), 1, 1,
+                0xFE, 4, 1, 1, 1, 1 };
+            parser.begin();
+            parser.feed(message, sizeof(message));
+            parser.end();
+            TDA7419::RegisterImage after;
+            dev.getRegisterImage(after);
+            const bool overhangOk = parser.getApplied() == 1 && parser.getRejected() == 6 && after == before;
+            std::printf("binary runs past the last parameter: %u applied, %u rejected, image %s\n",
+                parser.getApplied(), parser.getRejected(), after == before ? "unchanged" : "CHANGED");
+            ok = ok && overhangOk;
+        }
+
+        // a phone app sending one knob as text
+        Device dev;
+        prepare(dev);
+        TDA7419::StateParser parser(dev);
+        const char message[] = "{\"masterVolume\":-12,\"bassLevel\":4,\"newFeature\":1,\"trebleLevel\":99}";
+        parser.feed(reinterpret_cast<const uint8_t*>(message), sizeof(message) - 1);
+        parser.end();
+        std::printf("partial json: %u applied, %u rejected (unknown key, out of range), %zu bursts\n",
+            parser.getApplied(), parser.getRejected(), Wire.transactions().size());
+        ok = ok && parser.getApplied() == 2 && parser.getRejected() == 2 && dev.getMasterVolume() == -12 && dev.getBassLevel() == 4;
+
+        std::printf("state check: %s\n", ok ? "ok" : "FAIL");
+        return ok;
+    }
+
+    // Remote side of the framed protocol: checks and unwraps one response frame
+    bool decodeResponse(const std::vector<uint8_t>& frame, uint8_t& command, std::vector<uint8_t>& payload) {
+        if (frame.size() < TDA7419::FRAME_OVERHEAD + 1 || frame[0] != TDA7419::FRAME_SOF ||
+            frame.size() != static_cast<size_t>(frame[1]) + TDA7419::FRAME_OVERHEAD) {
+            return false;
+        }
+        uint16_t crc = 0xFFFF;
+        for (size_t i = 1; i < frame.size() - 2; ++i) {
+            crc = TDA7419::frameCrc(crc, frame[i]);
+        }
+        if (crc != (frame[frame.size() - 2] | frame[frame.size() - 1] << 8)) {
+            return false;
+        }
+        command = frame[2];
+        payload.assign(frame.begin() + 3, frame.end() - 2);
+        return true;
+    }
+
+    void collectResponse(void* context, const uint8_t* data, uint8_t length) {
+        auto& out = *static_cast<std::vector<uint8_t>*>(context);
+        out.insert(out.end(), data, data + length);
+    }
+
+    // Framed protocol loopback: remote frames in, responses decoded and checked
+    bool benchProtocol() {
+        std::printf("\nFramed protocol loopback (host CPU, responses CRC-checked; bus time @100kHz)\n");
+        std::printf("%-26s %6s %7s %12s %12s %14s %8s %12s\n", "frame", "bytes", "params", "frames/s", "params/s",
+            "params/s@115k2", "bursts", "bus us");
+
+        using TDA7419::ParamId;
+        auto id = [](ParamId p) { return static_cast<uint8_t>(p); };
+        const uint8_t batch[] = {
+            id(ParamId::MasterVolume), id(ParamId::SpeakerLFVolume), id(ParamId::SpeakerRFVolume), id(ParamId::SpeakerLRVolume),
+            id(ParamId::SpeakerRRVolume), id(ParamId::SubwooferVolume), id(ParamId::MixingChannelVolume), id(ParamId::BassLevel),
+            id(ParamId::MiddleLevel), id(ParamId::TrebleLevel), id(ParamId::InputGain), id(ParamId::LoudnessAttenuation),
+            id(ParamId::BassCenterFreq), id(ParamId::MiddleCenterFreq), id(ParamId::TrebleCenterFreq), id(ParamId::SubCutoffFreq),
+        };
+
+        Device dev;
+        prepare(dev);
+        std::vector<uint8_t> responses;
+        TDA7419::FrameProtocol protocol(dev, collectResponse, &responses);
+
+        bool ok = true;
+        uint8_t frame[TDA7419::FRAME_MAX_LENGTH + TDA7419::FRAME_OVERHEAD];
+        uint8_t payload[TDA7419::FRAME_MAX_LENGTH];
+
+        // build the request for a round: the values alternate so every Set frame changes registers
+        auto build = [&](int kind, int round, uint8_t& params) -> uint8_t {
+            const int8_t step = static_cast<int8_t>(round & 1);
+            switch (kind) {
+            case 0:
+                payload[0] = id(ParamId::MasterVolume);
+                payload[1] = static_cast<uint8_t>(-10 - step);
+                params = 1;
+                return TDA7419::encodeFrame(static_cast<uint8_t>(TDA7419::FrameCommand::Set), payload, 2, frame);
+            case 1:
+                for (uint8_t i = 0; i < sizeof(batch); ++i) {
+                    payload[2 * i] = batch[i];
+                    payload[2 * i + 1] = static_cast<uint8_t>(i < 7 ? -10 - step : (i < 12 ? 2 + step : step));
+                }
+                params = sizeof(batch);
+                return TDA7419::encodeFrame(static_cast<uint8_t>(TDA7419::FrameCommand::Set), payload, 2 * sizeof(batch), frame);
+            case 2:
+                payload[0] = 0;
+                for (uint8_t p = 0; p < TDA7419::PARAM_COUNT; ++p) {
+                    payload[1 + p] = static_cast<uint8_t>(TDA7419::getParam(dev, p));
+                }
+                payload[1 + id(ParamId::MasterVolume)] = static_cast<uint8_t>(-20 - step);
+                payload[1 + id(ParamId::BassLevel)] = static_cast<uint8_t>(step);
+                params = TDA7419::PARAM_COUNT;
+                return TDA7419::encodeFrame(static_cast<uint8_t>(TDA7419::FrameCommand::SetRun), payload, 1 + TDA7419::PARAM_COUNT, frame);
+            case 3:
+                std::copy(batch, batch + 8, payload);
+                params = 8;
+                return TDA7419::encodeFrame(static_cast<uint8_t>(TDA7419::FrameCommand::Get), payload, 8, frame);
+            default:
+                params = TDA7419::PARAM_COUNT;
+                return TDA7419::encodeFrame(static_cast<uint8_t>(TDA7419::FrameCommand::GetAll), payload, 0, frame);
+            }
+        };
+
+        const char* names[] = { "Set, 1 parameter", "Set, 16 parameters", "SetRun, full state", "Get, 8 parameters", "GetAll" };
+        for (int kind = 0; kind < 5; ++kind) {
+            // loopback check of one round: the response matches the shadow
+            uint8_t params = 0;
+            const uint8_t size = build(kind, 1, params);
+            responses.clear();
+            Wire.clearLog();
+            protocol.feed(frame, size);
+            const size_t bursts = Wire.transactions().size();
+            const double busUs = Wire.totalNanos() / 1000.0;
+
+            uint8_t command = 0;
+            std::vector<uint8_t> reply;
+            ok = ok && decodeResponse(responses, command, reply) && command == (frame[2] | TDA7419::FRAME_RESPONSE_BIT);
+            if (kind <= 2) {
+                ok = ok && reply.size() == 3 && reply[0] == params && reply[1] == 0 && reply[2] == 0;
+            }
+            else if (kind == 3) {
+                for (size_t i = 0; ok && i + 1 < reply.size(); i += 2) {
+                    ok = static_cast<int8_t>(reply[i + 1]) == TDA7419::getParam(dev, reply[i]);
+                }
+                ok = ok && reply.size() == 16;
+            }
+            else {
+                ok = ok && reply.size() == 1u + TDA7419::PARAM_COUNT;
+                for (uint8_t p = 0; ok && p < TDA7419::PARAM_COUNT; ++p) {
+                    ok = static_cast<int8_t>(reply[1 + p]) == TDA7419::getParam(dev, p);
+                }
+            }
+
+            constexpr int iterations = 50000;
+            const auto start = std::chrono::steady_clock::now();
+            for (int round = 0; round < iterations; ++round) {
+                const uint8_t n = build(kind, round, params);
+                responses.clear();
+                protocol.feed(frame, n);
+                if ((round & 1023) == 0) {
+                    Wire.clearLog();
+                }
+            }
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            const double uartFrames = 115200.0 / 10 / size;
+            std::printf("%-26s %6u %7u %12.0f %12.0f %14.0f %8zu %12.1f\n", names[kind], size, params, iterations / seconds,
+                iterations * params / seconds, uartFrames * params, bursts, busUs);
+        }
+
+        // a Get of more ids than fit in the answer is capped at one full response frame
+        {
+            uint8_t ids[TDA7419::FRAME_MAX_LENGTH - 1];
+            for (uint8_t i = 0; i < sizeof(ids); ++i) {
+                ids[i] = i % TDA7419::PARAM_COUNT;
+            }
+            const uint8_t n = TDA7419::encodeFrame(static_cast<uint8_t>(TDA7419::FrameCommand::Get), ids, sizeof(ids), frame);
+            responses.clear();
+            protocol.feed(frame, n);
+            uint8_t command = 0;
+            std::vector<uint8_t> reply;
+            bool capped = decodeResponse(responses, command, reply) && responses.size() <= TDA7419::FRAME_MAX_LENGTH + TDA7419::FRAME_OVERHEAD &&
+                reply.size() == 2u * TDA7419::FRAME_GET_MAX_PAIRS;
+            for (size_t i = 0; capped && i + 1 < reply.size(); i += 2) {
+                capped = reply[i] == ids[i / 2] && static_cast<int8_t>(reply[i + 1]) == TDA7419::getParam(dev, reply[i]);
+            }
+            std::printf("Get of %zu ids: %zu pairs in a %zu-byte frame\n", sizeof(ids), reply.size() / 2, responses.size());
+            ok = ok && capped;
+        }
+
+        // a corrupted frame is dropped without touching the shadow
+        const int8_t before = dev.getMasterVolume();
+        uint8_t params = 0;
+        const uint8_t size = build(0, 0, params);
+        frame[3] ^= 0x01;
+        const uint32_t errors = protocol.getErrorCount();
+        responses.clear();
+        protocol.feed(frame, size);
+        ok = ok && protocol.getErrorCount() == errors + 1 && responses.empty() && dev.getMasterVolume() == before;
+
+        std::printf("loopback %s, %u frames, %u dropped\n", ok ? "ok" : "FAILED", protocol.getFrameCount(), protocol.getErrorCount());
+        return ok;
+    }
+
+    // Gain planning: a -60..0..-60 dB ramp with rear -3 dB and subwoofer +4 dB trims
+    bool benchGainPlanner() {
+        std::printf("\nGain ramp -60..0..-60 dB in 1 dB steps, rear -3, sub +4, 6 dB source headroom @100kHz\n");
+        std::printf("%-24s %6s %6s %12s %14s %10s\n", "method", "trans", "bytes", "regs/step", "noise dB (avg)", "us/plan");
+
+        const int8_t trims[TDA7419::GAIN_CHANNEL_COUNT] = { 0, 0, -3, -3, 4 };
+        std::vector<int8_t> ramp;
+        for (int t = -60; t <= 0; ++t) ramp.push_back(static_cast<int8_t>(t));
+        for (int t = -1; t >= -60; --t) ramp.push_back(static_cast<int8_t>(t));
+
+        auto report = [&](const char* name, double noiseSum, size_t steps, uint32_t regs, double planNs) {
+            std::printf("%-24s %6zu %6zu %12.2f %14.1f %10.1f\n", name, Wire.transactions().size(), Wire.totalBytes(),
+                static_cast<double>(regs) / steps, 10.0 * std::log10(noiseSum / steps / 4096.0), planNs / 1000.0);
+        };
+
+        // by hand: input gain 0, target on the master, trims on the channels
+        {
+            Device dev;
+            prepare(dev);
+            double noiseSum = 0;
+            uint32_t regs = 0;
+            for (int8_t target : ramp) {
+                const uint32_t before = dev.getDirtyMask();
+                dev.setInputGain(0);
+                dev.setMasterVolume(target);
+                for (uint8_t ch = 0; ch < TDA7419::SPEAKER_CHANNEL_COUNT; ++ch) {
+                    dev.setSpeakerVolume(static_cast<TDA7419::SpeakerChannel>(ch), trims[ch]);
+                }
+                dev.setSubwooferVolume(trims[4]);
+                regs += __builtin_popcount(dev.getDirtyMask() & ~before);
+                for (uint8_t ch = 0; ch < TDA7419::GAIN_CHANNEL_COUNT; ++ch) {
+                    noiseSum += TDA7419::gainNoiseWeight(trims[ch] + target) * 2 + TDA7419::gainNoiseWeight(trims[ch]);
+                }
+                dev.sendChangedRegisters();
+            }
+            report("master only (by hand)", noiseSum, ramp.size(), regs, 0);
+        }
+
+        for (uint8_t tolerance : { 0, 1, 3 }) {
+            Device dev;
+            prepare(dev);
+            TDA7419::GainPlanner planner(dev);
+            planner.setHeadroom(6);
+            planner.setTolerance(tolerance);
+            for (uint8_t ch = 0; ch < TDA7419::GAIN_CHANNEL_COUNT; ++ch) {
+                planner.setTrim(static_cast<TDA7419::GainChannel>(ch), trims[ch]);
+            }
+
+            double noiseSum = 0;
+            uint32_t regs = 0;
+            double planNs = 0;
+            for (int8_t target : ramp) {
+                const auto start = std::chrono::steady_clock::now();
+                const TDA7419::GainPlan plan = planner.apply(target);
+                planNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+                regs += plan.changedRegisters;
+                noiseSum += plan.noiseWeight;
+                dev.sendChangedRegisters();
+            }
+
+            char name[32];
+            std::snprintf(name, sizeof(name), "planner, tolerance %u dB", tolerance);
+            report(name, noiseSum, ramp.size(), regs, planNs / ramp.size());
+        }
+
+        // far out of range the summed error exceeds 255 dB and must still be exact
+        Device dev;
+        TDA7419::GainPlanner planner(dev);
+        for (uint8_t ch = 0; ch < TDA7419::GAIN_CHANNEL_COUNT; ++ch) {
+            planner.setTrim(static_cast<TDA7419::GainChannel>(ch), -100);
+        }
+        const TDA7419::GainPlan plan = planner.plan(-128);
+        uint32_t errorDb = 0;
+        for (uint8_t ch = 0; ch < TDA7419::GAIN_CHANNEL_COUNT; ++ch) {
+            const int reached = plan.inputGain - dev.getLoudnessAttenuation() + plan.masterVolume + plan.channel[ch];
+            errorDb += std::abs(reached - (-128 - 100));
+        }
+
+        // -80 is the mute code: no plan may reach for it, down to the bottom of the range
+        auto audible = [](const TDA7419::GainPlan& p) {
+            bool result = p.masterVolume > TDA7419::MIN_SPEAKER_VOLUME;
+            for (int8_t volume : p.channel) {
+                result = result && volume > TDA7419::MIN_SPEAKER_VOLUME;
+            }
+            return result;
+        };
+        bool neverMuted = audible(plan);
+        TDA7419::GainPlanner bottom(dev);
+        for (int target = -60; target >= -128; --target) {
+            neverMuted = neverMuted && audible(bottom.apply(static_cast<int8_t>(target)));
+        }
+
+        const bool ok = errorDb > 255 && plan.errorDb == errorDb && neverMuted;
+        std::printf("unreachable -228 dB: error %u dB reported, %u dB actual, mute code %s; planner check: %s\n",
+            static_cast<unsigned>(plan.errorDb), static_cast<unsigned>(errorDb), neverMuted ? "avoided" : "USED",
+            ok ? "ok" : "FAIL");
+        return ok;
+    }
+
+    // true when the tracker wrote register 1 once per contour boundary crossed and ignored the wobble
+    bool benchLoudness() {
+        std::printf("\nLoudness tracking: master ramp +5..-79..+5 dB in 1 dB steps, then 100 detents wobbling on the -20 dB boundary\n");
+        std::printf("%-26s %-7s %6s %6s %10s\n", "method", "input", "trans", "bytes", "reg1 writes");
+
+        std::vector<int8_t> ramp;
+        for (int v = 5; v >= -79; --v) ramp.push_back(static_cast<int8_t>(v));
+        for (int v = -78; v <= 5; ++v) ramp.push_back(static_cast<int8_t>(v));
+        std::vector<int8_t> wobble;
+        for (int i = 0; i < 100; ++i) wobble.push_back(static_cast<int8_t>(i & 1 ? -21 : -20));
+
+        // contour boundaries crossed by the ramp, down and back up
+        const uint32_t boundaries = 2 * (TDA7419::DEFAULT_LOUDNESS_STEP_COUNT - 1);
+
+        bool ok = true;
+        for (int method = 0; method < 4; ++method) {
+            const uint8_t hysteresis = method == 3 ? TDA7419::DEFAULT_LOUDNESS_HYSTERESIS_DB : 0;
+            const char* names[] = { "volume only", "attenuation = -volume/5", "tracker, no hysteresis", "tracker, 2 dB hysteresis" };
+
+            for (const std::vector<int8_t>* input : { &ramp, &wobble }) {
+                Device dev;
+                prepare(dev);
+                dev.setMasterVolume((*input)[0]);
+                TDA7419::LoudnessTracker tracker(dev);
+                tracker.setHysteresis(hysteresis);
+                tracker.update();
+                dev.sendChangedRegisters();
+                TDA7419::RegisterImage chip;
+                dev.getRegisterImage(chip);
+                Wire.clearLog();
+
+                for (int8_t volume : *input) {
+                    dev.setMasterVolume(volume);
+                    if (method == 1) {
+                        // the naive mapping: attenuation recomputed from every volume change
+                        dev.setLoudnessAttenuation(static_cast<uint8_t>(volume < 0 ? -volume / 5 : 0));
+                    }
+                    else if (method >= 2) {
+                        tracker.update();
+                    }
+                    dev.sendChangedRegisters();
+                }
+
+                uint32_t reg1 = 0;
+                for (const I2CTransaction& t : Wire.transactions()) {
+                    reg1 += covers(t, TDA7419::REG_LOUDNESS_CONTROL);
+                }
+                std::printf("%-26s %-7s %6zu %6zu %10u\n", names[method], input == &ramp ? "ramp" : "wobble",
+                    Wire.transactions().size(), Wire.totalBytes(), reg1);
+
+                if (method >= 2) {
+                    // a ramp crosses every boundary twice; only the unfiltered tracker follows the wobble
+                    const uint32_t expected = input == &ramp ? boundaries : (hysteresis == 0 ? wobble.size() - 1 : 0);
+                    // decode what the chip received; its high boost bit is active low
+                    const TDA7419::LoudnessStep& last = TDA7419::DEFAULT_LOUDNESS_CONTOUR[tracker.getStepIndex()];
+                    applyTraffic(chip);
+                    Device decoder;
+                    decoder.setRegisterImage(chip);
+                    ok = ok && reg1 == expected && decoder.getLoudnessAttenuation() == last.attenuation &&
+                        decoder.getLoudnessHighBoost() == !last.highBoost;
+                }
+            }
+        }
+
+        std::printf("loudness tracker check: %s\n", ok ? "ok" : "FAIL");
+        return ok;
+    }
+
+    // Scalar reference: std::complex in double, one point at a time
+    __attribute__((noinline)) void responseReference(const ResponseModel& model, float* magnitudeDb, float* phaseDeg) {
+        const double offset = model.isMuted() ? ResponseModel::MUTED_DB : model.getGainDb();
+        for (size_t i = 0; i < model.size(); ++i) {
+            std::complex<double> h = 1.0;
+            for (uint8_t k = 0; k < model.getSectionCount(); ++k) {
+                const ResponseModel::Section& s = model.getSection(k);
+                const std::complex<double> p(0.0, static_cast<double>(model.frequencies()[i]) / s.f0);
+                h *= (static_cast<double>(s.b2) * p * p + static_cast<double>(s.b1) * p + static_cast<double>(s.b0)) /
+                     (static_cast<double>(s.a2) * p * p + static_cast<double>(s.a1) * p + static_cast<double>(s.a0));
+            }
+            magnitudeDb[i] = static_cast<float>(20.0 * std::log10(std::abs(h)) + offset);
+            phaseDeg[i] = static_cast<float>(std::arg(h) * 180.0 / 3.14159265358979);
+        }
+    }
+
+    // Magnitude at one frequency, for the shape checks
+    float responseAt(const TDA7419::RegisterImage& image, ResponseOutput output, float hz) {
+        ResponseModel model(std::vector<float>{ hz });
+        model.load(image, output);
+        float magnitude = 0.0f;
+        model.evaluate(&magnitude, nullptr);
+        return magnitude;
+    }
+
+    bool benchResponse() {
+        constexpr size_t points = 2048;
+        constexpr uint32_t imageCount = 256;
+        std::printf("\nResponse model: %zu log-spaced points 20 Hz..20 kHz, %u varied register images\n", points, imageCount);
+
+        // neutral image: every gain 0 dB, no loudness, no tone
+        Device dev;
+        dev.setInputGain(0);
+        dev.setLoudnessAttenuation(0);
+        dev.setMasterVolume(0);
+        dev.setBassLevel(0);
+        dev.setMiddleLevel(0);
+        dev.setTrebleLevel(0);
+        for (uint8_t ch = 0; ch < TDA7419::SPEAKER_CHANNEL_COUNT; ++ch) {
+            dev.setSpeakerVolume(static_cast<TDA7419::SpeakerChannel>(ch), 0);
+        }
+        TDA7419::RegisterImage neutral;
+        dev.getRegisterImage(neutral);
+
+        ResponseModel model(points, 20.0f, 20000.0f);
+        std::vector<float> magnitude(points), phase(points), refMagnitude(points), refPhase(points);
+
+        model.load(neutral, ResponseOutput::LeftFront);
+        model.evaluate(magnitude.data(), phase.data());
+        float flatError = 0.0f;
+        for (size_t i = 0; i < points; ++i) {
+            flatError = std::max(flatError, std::max(std::fabs(magnitude[i]), std::fabs(phase[i])));
+        }
+
+        // shapes at their defining frequencies
+        TDA7419::RegisterImage image;
+        dev.setBassLevel(10);
+        dev.setBassCenterFreq(TDA7419::BassCenterFreq::Hz100);
+        dev.setBassDcMode(true);          // bit 1: DC mode off, the chip reads these bits active low
+        dev.getRegisterImage(image);
+        const float bassPeak = responseAt(image, ResponseOutput::LeftFront, 100.0f);
+        dev.setBassLevel(0);
+        dev.setSubCutoffFreq(TDA7419::SubCutoffFreq::Hz80);
+        dev.setSubwooferEnable(false);    // bit 0: subwoofer on
+        dev.getRegisterImage(image);
+        const float subCorner = responseAt(image, ResponseOutput::Subwoofer, 80.0f);
+
+        // varied images through the public setters, so every field holds a valid code
+        std::vector<TDA7419::RegisterImage> images(imageCount);
+        uint32_t seed = 12345;
+        auto next = [&seed](uint32_t range) {
+            seed = seed * 1664525u + 1013904223u;
+            return (seed >> 8) % range;
+        };
+        for (TDA7419::RegisterImage& img : images) {
+            dev.setLoudnessAttenuation(static_cast<uint8_t>(next(16)));
+            dev.setLoudnessCenterFreq(static_cast<TDA7419::LoudnessCenterFreq>(next(4)));
+            dev.setLoudnessHighBoost(next(2) != 0);
+            dev.setBassLevel(static_cast<int8_t>(next(31)) - 15);
+            dev.setBassCenterFreq(static_cast<TDA7419::BassCenterFreq>(next(4)));
+            dev.setBassQFactor(static_cast<TDA7419::BassQFactor>(next(4)));
+            dev.setBassDcMode(next(2) != 0);
+            dev.setMiddleLevel(static_cast<int8_t>(next(31)) - 15);
+            dev.setMiddleCenterFreq(static_cast<TDA7419::MiddleCenterFreq>(next(4)));
+            dev.setMiddleQFactor(static_cast<TDA7419::MiddleQFactor>(next(4)));
+            dev.setTrebleLevel(static_cast<int8_t>(next(31)) - 15);
+            dev.setTrebleCenterFreq(static_cast<TDA7419::TrebleCenterFreq>(next(4)));
+            dev.setMasterVolume(static_cast<int8_t>(next(40)) - 30);
+            dev.getRegisterImage(img);
+        }
+
+        // struct-of-arrays path against the double-precision scalar reference
+        float magnitudeError = 0.0f;
+        float phaseError = 0.0f;
+        for (const TDA7419::RegisterImage& img : images) {
+            model.load(img, ResponseOutput::LeftFront);
+            model.evaluate(magnitude.data(), phase.data());
+            responseReference(model, refMagnitude.data(), refPhase.data());
+            for (size_t i = 0; i < points; ++i) {
+                magnitudeError = std::max(magnitudeError, std::fabs(magnitude[i] - refMagnitude[i]));
+                const float wrapped = std::fmod(phase[i] - refPhase[i] + 540.0f, 360.0f) - 180.0f;
+                phaseError = std::max(phaseError, std::fabs(wrapped));
+            }
+        }
+
+        std::printf("%-34s %12s %12s\n", "method", "curves/s", "ns/point");
+        auto report = [&](const char* name, uint32_t rounds, auto&& evaluate) {
+            const auto start = std::chrono::steady_clock::now();
+            for (uint32_t round = 0; round < rounds; ++round) {
+                for (const TDA7419::RegisterImage& img : images) {
+                    model.load(img, ResponseOutput::LeftFront);
+                    evaluate();
+                }
+            }
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            const double curves = static_cast<double>(rounds) * imageCount;
+            std::printf("%-34s %12.0f %12.2f\n", name, curves / seconds, seconds * 1e9 / (curves * points));
+        };
+        report("scalar std::complex<double>", 2, [&] { responseReference(model, refMagnitude.data(), refPhase.data()); });
+        report("struct of arrays, magnitude+phase", 20, [&] { model.evaluate(magnitude.data(), phase.data()); });
+        report("struct of arrays, magnitude", 20, [&] { model.evaluate(magnitude.data(), nullptr); });
+
+        const bool ok = flatError < 0.001f && std::fabs(bassPeak - 10.0f) < 0.01f && std::fabs(subCorner + 3.01f) < 0.01f &&
+            magnitudeError < 0.01f && phaseError < 0.05f;
+        std::printf("neutral image max |dB|,|deg| %.4f; bass +10 dB @100 Hz: %.3f dB; sub 80 Hz corner: %.3f dB\n",
+            flatError, bassPeak, subCorner);
+        std::printf("vs reference: max %.5f dB, %.4f deg\n", magnitudeError, phaseError);
+        std::printf("response model check: %s\n", ok ? "ok" : "FAIL");
+        return ok;
+    }
+
+    bool benchFade() {
+        std::printf("\nMaster fade 0 -> -40 dB over 500 ms, update()+poll() every 1 ms @100kHz\n");
+        std::printf("%-12s %-8s %6s %6s %12s %14s\n", "soft-step", "curve", "trans", "bytes", "bus us", "min gap us");
+        const struct { const char* name; TDA7419::SoftStepTime time; } steps[] = {
+            { "160us", TDA7419::SoftStepTime::Us160 },
+            { "5.12ms", TDA7419::SoftStepTime::Us5120 },
+            { "20.48ms", TDA7419::SoftStepTime::Us20480 },
+        };
+        const struct { const char* name; TDA7419::FadeCurve curve; } curves[] = {
+            { "linear", TDA7419::FadeCurve::Linear },
+            { "s-curve", TDA7419::FadeCurve::SCurve },
+        };
+
+        bool ok = true;
+        for (const auto& step : steps) {
+            for (const auto& curve : curves) {
+                Device dev;
+                dev.setSoftStepTime(step.time);
+                Wire.clearLog();
+                dev.begin();
+                TDA7419::RegisterImage chip{};
+                applyTraffic(chip);
+                Wire.clearLog();
+
+                TDA7419::VolumeFader fader(dev);
+                fader.fadeTo(TDA7419::FadeChannel::Master, -40, 500, curve.curve);
+                uint32_t loops = 0;
+                while (fader.isActive() && loops < 2000) {
+                    fader.update();
+                    dev.poll(1000);
+                    delay(1);
+                    ++loops;
+                }
+                applyTraffic(chip);
+
+                // the chip must get at least one soft-step time per write to ramp
+                uint64_t minGapNs = UINT64_MAX;
+                uint64_t lastNs = 0;
+                for (const I2CTransaction& t : Wire.transactions()) {
+                    if (covers(t, TDA7419::REG_MASTER_VOLUME)) {
+                        if (lastNs != 0) {
+                            minGapNs = std::min<uint64_t>(minGapNs, t.startNs - lastNs);
+                        }
+                        lastNs = t.startNs;
+                    }
+                }
+
+                std::printf("%-12s %-8s %6zu %6zu %12.1f %14.1f\n", step.name, curve.name,
+                    Wire.transactions().size(), Wire.totalBytes(), Wire.totalNanos() / 1000.0, minGapNs / 1000.0);
+                ok = ok && !fader.isActive() && dev.getMasterVolume() == -40 &&
+                    chip[TDA7419::REG_MASTER_VOLUME] == dev.getRegisterValue(TDA7419::REG_MASTER_VOLUME) &&
+                    minGapNs >= static_cast<uint64_t>(fader.getStepIntervalMicros()) * 1000;
+            }
+        }
+
+        // a duration beyond the limit is clamped instead of wrapping to a short fade
+        Device dev;
+        TDA7419::VolumeFader fader(dev);
+        const uint32_t start = micros();
+        fader.fadeTo(TDA7419::FadeChannel::Master, -40, 5000000UL);
+        fader.update(start + 20UL * 60 * 1000000);
+        const bool halfway = fader.isFading(TDA7419::FadeChannel::Master);
+        fader.update(start + TDA7419::MAX_FADE_DURATION_MS * 1000UL);
+        const bool longOk = halfway && !fader.isActive() && dev.getMasterVolume() == -40;
+        std::printf("83 min fade: %s after 20 min, done at the %lu ms limit: %s\n", halfway ? "running" : "DONE",
+            static_cast<unsigned long>(TDA7419::MAX_FADE_DURATION_MS), longOk ? "yes" : "NO");
+
+        ok = ok && longOk;
+        std::printf("fader check: %s\n", ok ? "ok" : "FAIL");
+        return ok;
+    }
+
+    bool benchGroup() {
+        std::printf("\nGroup: 4 devices behind a 2-channel mux and 1 direct on Wire, 2 on a second bus, same volume change on all @100kHz\n");
+        std::printf("%-8s %4s %6s %6s %6s %10s\n", "device", "ch", "flush", "trans", "bytes", "bus us");
+
+        TDA7419::BusMux mux([](void*, uint8_t channel) {
+            // PCA9548-style channel select: one byte to the mux address
+            Wire.beginTransmission(0x70);
+            Wire.write(static_cast<uint8_t>(1u << channel));
+            Wire.endTransmission();
+        });
+
+        // devices without a mux on both buses, added in between
+        TwoWire wire1;
+        Device a, b, c(Wire, 0x45), d(Wire, 0x45), e(wire1), f(wire1, 0x45), g(Wire, 0x46);
+        a.setBusMux(&mux, 1);
+        b.setBusMux(&mux, 0);
+        c.setBusMux(&mux, 1);
+        d.setBusMux(&mux, 0);
+
+        TDA7419::TDA7419Group<7> group;
+        for (Device* dev : { &a, &e, &g, &b, &c, &f, &d }) {
+            group.add(*dev);
+        }
+        group.flush();
+        group.resetStats();
+        Wire.clearLog();
+        wire1.clearLog();
+        const uint32_t switchesBefore = mux.getSwitchCount();
+
+        group.apply([](Device& dev) {
+            dev.setMasterVolume(-12);
+            dev.setSubwooferVolume(-6);
+        });
+
+        // flush order must finish one bus before the next
+        uint8_t busChanges = 0;
+        bool allSent = true;
+        for (uint8_t i = 0; i < group.size(); ++i) {
+            const auto& st = group.getStats(i);
+            std::printf("%-8u %4u %6lu %6lu %6lu %10lu  %s\n", i, group[i].getBusMuxChannel(),
+                static_cast<unsigned long>(st.flushes), static_cast<unsigned long>(st.transactions),
+                static_cast<unsigned long>(st.bytes), static_cast<unsigned long>(st.busMicros),
+                &group[i].getBus().getWire() == &Wire ? "Wire" : "wire1");
+            if (i > 0 && &group[i].getBus().getWire() != &group[i - 1].getBus().getWire()) {
+                ++busChanges;
+            }
+            allSent = allSent && st.transactions > 0 && group[i].getMasterVolume() == -12;
+        }
+        const uint32_t switches = mux.getSwitchCount() - switchesBefore;
+        std::printf("mux switches: %lu, bus transactions incl. mux: %zu + %zu, total bus us: %.1f\n",
+            static_cast<unsigned long>(switches), Wire.transactions().size(), wire1.transactions().size(),
+            (Wire.totalNanos() + wire1.totalNanos()) / 1000.0);
+
+        // one switch per mux channel and one bus change
+        const bool ok = allSent && !group.isFlushPending() && switches == 2 && busChanges == 1 &&
+            wire1.transactions().size() == 4;
+        std::printf("group check: %s\n", ok ? "ok" : "FAIL");
+        return ok;
+    }
+
+    // Every changed register is written, and each burst starts and ends on a changed register
+    // (unchanged ones are only sent to bridge a gap inside a burst)
+    bool sendsOnlyChanges(const TDA7419::RegisterImage& before, const TDA7419::RegisterImage& after) {
+        TDA7419::RegisterImage chip = before;
+        for (const I2CTransaction& t : Wire.transactions()) {
+            if (t.result != 0 || t.data.size() < 2) {
+                continue;
+            }
+            const uint8_t first = t.data[0] & 0x1F;
+            const bool autoIncrement = (t.data[0] & TDA7419::SUBADDR_AUTO_INCREMENT_BIT) != 0;
+            const uint8_t last = static_cast<uint8_t>(autoIncrement ? first + t.data.size() - 2 : first);
+            if (last >= TDA7419::REGISTER_COUNT || before[first] == after[first] || before[last] == after[last]) {
+                return false;
+            }
+        }
+        applyTraffic(chip);
+        return chip == after;
+    }
+
+    bool benchPresets() {
+        constexpr uint8_t presetCount = 20;
+        std::printf("\nPreset switching, %u presets, every ordered pair @100kHz (file-backed store)\n", presetCount);
+
+        FilePresetStore store("build/presets.bin", presetCount);
+        {
+            // typical sound presets: same routing, different tone/volume settings
+            Device dev;
+            TDA7419::PresetBank<FilePresetStore> bank(dev, store);
+            for (uint8_t i = 0; i < presetCount; ++i) {
+                dev.setBassLevel(static_cast<int8_t>(i % 7) - 3);
+                dev.setMiddleLevel(static_cast<int8_t>(i % 5) - 2);
+                dev.setTrebleLevel(static_cast<int8_t>(i % 4));
+                dev.setLoudnessAttenuation(i % 3 == 0 ? 4 : 0);
+                dev.setSubwooferVolume(static_cast<int8_t>(-(i % 6)));
+                if (i % 4 == 0) dev.setBassCenterFreq(TDA7419::BassCenterFreq::Hz80);
+                bank.storePreset(i);
+            }
+        }
+
+        Device dev;
+        TDA7419::PresetBank<FilePresetStore> bank(dev, store);
+        prepare(dev);
+
+        uint32_t switches = 0;
+        uint64_t worstNs = 0;
+        bool diffOk = true;
+        for (uint8_t from = 0; from < presetCount; ++from) {
+            for (uint8_t to = 0; to < presetCount; ++to) {
+                if (from == to) continue;
+                bank.recallPreset(from);
+                Wire.clearLog();
+                TDA7419::RegisterImage before, after;
+                store.load(from, before);
+                store.load(to, after);
+                const bool sent = bank.recallPreset(to) == TDA7419::PresetResult::OK;
+                diffOk = diffOk && sent && sendsOnlyChanges(before, after);
+                worstNs = std::max<uint64_t>(worstNs, Wire.totalNanos());
+                ++switches;
+            }
+        }
+        // measure the average over a simple cycle through all presets
+        Wire.clearLog();
+        for (uint8_t i = 0; i < presetCount; ++i) {
+            bank.recallPreset(i);
+        }
+        const double diffAvgUs = Wire.totalNanos() / 1000.0 / presetCount;
+        const double diffAvgBytes = static_cast<double>(Wire.totalBytes()) / presetCount;
+
+        Wire.clearLog();
+        dev.sendAllRegisters();
+        const double fullUs = Wire.totalNanos() / 1000.0;
+
+        std::printf("%-28s %10s %10s\n", "method", "bytes", "us");
+        std::printf("%-28s %10.1f %10.1f (worst %.1f over %u switches)\n", "recallPreset (diff)", diffAvgBytes, diffAvgUs, worstNs / 1000.0, switches);
+        std::printf("%-28s %10zu %10.1f\n", "sendAllRegisters", Wire.totalBytes(), fullUs);
+
+        // an invalid slot is reported as such and leaves the device alone
+        TDA7419::RegisterImage kept, now;
+        dev.getRegisterImage(kept);
+        Wire.clearLog();
+        const bool invalidOk = bank.recallPreset(presetCount) == TDA7419::PresetResult::InvalidSlot;
+        dev.getRegisterImage(now);
+        const bool untouched = now == kept && Wire.transactions().empty() && !dev.isFlushPending();
+
+        const bool ok = diffOk && invalidOk && untouched;
+        std::printf("preset check: %s (diff sends %s, invalid slot %s)\n", ok ? "ok" : "FAIL",
+            diffOk ? "only changes" : "extra registers", invalidOk && untouched ? "rejected" : "NOT rejected");
+        return ok;
+    }
+
+    bool benchRecovery() {
+        std::printf("\nGlitch recovery: bass + subwoofer change, first 2 transactions NACKed @100kHz\n");
+        std::printf("%-26s %8s %6s %6s %10s %8s\n", "policy", "result", "trans", "bytes", "bus+wait us", "pending");
+
+        const struct { const char* name; uint8_t attempts; } policies[] = {
+            { "no retry, flush again", 1 },
+            { "3 attempts, 100us backoff", 3 },
+        };
+        for (const auto& policy : policies) {
+            Device dev;
+            TDA7419::RetryPolicy retry;
+            retry.maxAttempts = policy.attempts;
+            dev.setRetryPolicy(retry);
+            prepare(dev);
+
+            dev.setBassLevel(5);
+            dev.setSubwooferVolume(-4);
+            Wire.injectErrors(2, static_cast<uint8_t>(TDA7419::i2cResult::NACKOnData));
+
+            const uint64_t start = hostClock::nanos;
+            TDA7419::i2cResult result = dev.sendChangedRegisters();
+            if (dev.isFlushPending()) {
+                dev.sendChangedRegisters();
+            }
+            std::printf("%-26s %8u %6zu %6zu %10.1f %8s\n", policy.name, static_cast<unsigned>(result),
+                Wire.transactions().size(), Wire.totalBytes(), (hostClock::nanos - start) / 1000.0,
+                dev.isFlushPending() ? "yes" : "no");
+        }
+
+        // poll() must not block in the backoff past its budget: the retry moves to the next call
+        Device dev;
+        TDA7419::RetryPolicy retry;
+        retry.maxAttempts = 3;
+        retry.initialBackoffMicros = 2000;
+        dev.setRetryPolicy(retry);
+        prepare(dev);
+
+        constexpr uint32_t budgetMicros = 1000;
+        dev.setMasterVolume(-20);
+        Wire.injectErrors(1, static_cast<uint8_t>(TDA7419::i2cResult::NACKOnData));
+        uint64_t start = hostClock::nanos;
+        const TDA7419::i2cResult first = dev.poll(budgetMicros);
+        const uint64_t firstNs = hostClock::nanos - start;
+        const bool deferred = first != TDA7419::i2cResult::OK && dev.isFlushPending();
+
+        start = hostClock::nanos;
+        const TDA7419::i2cResult second = dev.poll(budgetMicros);
+        const uint64_t secondNs = hostClock::nanos - start;
+
+        // an unlimited budget (poll(0xFFFFFFFF), TDA7419Group::flush()) retries like sendChangedRegisters()
+        dev.setMasterVolume(-30);
+        Wire.injectErrors(1, static_cast<uint8_t>(TDA7419::i2cResult::NACKOnData));
+        const TDA7419::i2cResult unlimited = dev.poll(0xFFFFFFFFUL);
+        const bool unlimitedOk = unlimited == TDA7419::i2cResult::OK && !dev.isFlushPending();
+
+        TDA7419::TDA7419Group<1> group;
+        group.add(dev);
+        dev.setMasterVolume(-40);
+        Wire.injectErrors(1, static_cast<uint8_t>(TDA7419::i2cResult::NACKOnData));
+        const TDA7419::i2cResult grouped = group.flush();
+        const bool groupOk = grouped == TDA7419::i2cResult::OK && !dev.isFlushPending();
+
+        const bool ok = deferred && firstNs <= budgetMicros * 1000ULL &&
+            second == TDA7419::i2cResult::OK && secondNs <= budgetMicros * 1000ULL && !dev.isFlushPending() &&
+            unlimitedOk && groupOk;
+        std::printf("poll(%u us) with a 2 ms backoff: %.1f us, then %.1f us; unlimited poll %s, group flush %s; "
+            "retry check: %s\n", budgetMicros, firstNs / 1000.0, secondNs / 1000.0, unlimitedOk ? "retried" : "NOT retried",
+            groupOk ? "retried" : "NOT retried", ok ? "ok" : "FAIL");
+        return ok;
+    }
+
+    // Instrumentation counters after a mixed workload (fade, preset-like burst, a NACK burst)
+    void benchStats() {
+        std::printf("\nBus stats: 1 s fade + 4-speaker change + NACKed treble write, flushed again @100kHz\n");
+
+        Device dev;
+        prepare(dev);
+        dev.resetBusStats();
+
+        TDA7419::VolumeFader fader(dev);
+        fader.fadeTo(TDA7419::FadeChannel::Master, -40, 1000);
+        while (fader.isActive()) {
+            fader.update();
+            dev.poll(1000);
+            hostClock::advanceNanos(1000000);
+        }
+
+        {
+            TDA7419::UpdateGuard guard(dev);
+            for (uint8_t ch = 0; ch < 4; ++ch) {
+                dev.setSpeakerVolume(static_cast<TDA7419::SpeakerChannel>(ch), -6);
+            }
+        }
+
+        Wire.injectErrors(1, static_cast<uint8_t>(TDA7419::i2cResult::NACKOnData));
+        dev.setTrebleLevel(3);
+        dev.sendChangedRegisters();
+        dev.sendChangedRegisters();
+
+        Serial.enabled = true;
+        dev.printBusStats();
+        Serial.enabled = false;
+    }
+
+    // Spectrum read-out: blocking strobe loop vs SpectrumReader::service() on a 10 us tick
+    template<uint8_t Capacity>
+    void runSpectrum(const char* name, uint32_t framePeriodMicros, uint32_t readIntervalMicros) {
+        TDA7419::SpectrumTiming timing;
+        timing.framePeriodMicros = framePeriodMicros;
+        SpectrumSim sim(timing.settleMicros);
+        TDA7419::SpectrumReader<Capacity> reader(SpectrumSim::adc, SpectrumSim::clock, &sim);
+        reader.setTiming(timing);
+
+        constexpr uint32_t tickMicros = 10;
+        constexpr uint32_t runMicros = 1000000;
+        uint32_t published = 0;
+        uint32_t consumed = 0;
+        uint32_t mismatched = 0;
+
+        hostClock::reset();
+        reader.start();
+        for (uint32_t t = 0; t < runMicros; t += tickMicros) {
+            if (reader.service()) {
+                ++published;
+            }
+            if (t % readIntervalMicros == 0) {
+                TDA7419::SpectrumFrame frame;
+                while (reader.read(frame)) {
+                    ++consumed;
+                    // frames are only in sequence while nothing was dropped
+                    for (uint8_t band = 0; band < TDA7419::SPECTRUM_BAND_COUNT && reader.getOverruns() == 0; ++band) {
+                        if (frame.bands[band] != SpectrumSim::level(consumed - 1, band)) {
+                            ++mismatched;
+                            break;
+                        }
+                    }
+                }
+            }
+            hostClock::advanceNanos(tickMicros * 1000);
+        }
+
+        std::printf("%-30s %9u %9u %9u %9u %9u\n", name, static_cast<unsigned>(published), static_cast<unsigned>(consumed),
+            static_cast<unsigned>(reader.getOverruns()), static_cast<unsigned>(mismatched), static_cast<unsigned>(sim.unsettledSamples));
+    }
+
+    void benchSpectrum() {
+        TDA7419::SpectrumTiming timing;
+        std::printf("\nSpectrum read-out (1 s simulated, clock %u us, settle %u us)\n", timing.clockHighMicros, timing.settleMicros);
+
+        // what every sketch does today: strobe, wait, analogRead, 7 times in a row
+        SpectrumSim sim(timing.settleMicros);
+        hostClock::reset();
+        for (uint8_t band = 0; band < TDA7419::SPECTRUM_BAND_COUNT; ++band) {
+            SpectrumSim::clock(&sim, true);
+            delayMicroseconds(timing.clockHighMicros);
+            SpectrumSim::clock(&sim, false);
+            delayMicroseconds(timing.settleMicros);
+            SpectrumSim::adc(&sim);
+        }
+        std::printf("blocking loop: %.0f us busy-wait per frame; service(): no wait, 1 callback per call\n",
+            hostClock::nanos / 1000.0);
+
+        std::printf("%-30s %9s %9s %9s %9s %9s\n", "reader", "queued", "read", "overruns", "mismatch", "unsettled");
+        runSpectrum<4>("ring 4, 5 ms period, UI 20 ms", 5000, 20000);
+        runSpectrum<4>("ring 4, 5 ms period, UI 50 ms", 5000, 50000);
+        runSpectrum<16>("ring 16, 5 ms period, UI 50 ms", 5000, 50000);
+        runSpectrum<4>("ring 4, back-to-back, UI 1 ms", 0, 1000);
+    }
+
+    // Setter cost: the driver's setter against the pre-descriptor implementation, a
+    // bitStorage array written with writeValueAtBit(). Both are out-of-line calls.
+    using BitStorageRegisters = std::array<bitStorage, TDA7419::REGISTER_COUNT>;
+
+    __attribute__((noinline)) void setBassLevelBitStorage(BitStorageRegisters& regs, int8_t level) {
+        const int8_t clamped = std::min(std::max(level, TDA7419::MIN_EQ_LEVEL), TDA7419::MAX_EQ_LEVEL);
+        const uint8_t value = clamped >= 0 ? static_cast<uint8_t>(clamped + 16) : static_cast<uint8_t>(-clamped);
+        regs[TDA7419::REG_BASS_FILTER].writeValueAtBit(0, value, 5);
+    }
+
+    template<typename Fn>
+    double nanosPerCall(Fn fn) {
+        constexpr uint32_t iterations = 50000000;
+        const auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < iterations; ++i) {
+            // every call changes the level, so the setters do their full work
+            fn(static_cast<int8_t>(static_cast<int8_t>(i & 15) - 8));
+        }
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+    }
+
+    void benchFieldAccess() {
+        std::printf("\nSetter call (host CPU time)\n");
+
+        BitStorageRegisters regs;
+        const double bitStorageNs = nanosPerCall([&regs](int8_t level) { setBassLevelBitStorage(regs, level); });
+        volatile uint8_t sink = regs[TDA7419::REG_BASS_FILTER].getValue();
+
+        Device dev;
+        const double bassNs = nanosPerCall([&dev](int8_t level) { dev.setBassLevel(level); });
+        const double speakerNs = nanosPerCall([&dev](int8_t level) {
+            dev.setSpeakerVolume(TDA7419::SpeakerChannel::RightRear, level);
+        });
+        sink = dev.getRegisterValue(TDA7419::REG_BASS_FILTER);
+        (void)sink;
+
+        std::printf("%-40s %8.2f ns/call\n", "bitStorage::writeValueAtBit (no tracking)", bitStorageNs);
+        std::printf("%-40s %8.2f ns/call\n", "TDA7419::setBassLevel", bassNs);
+        std::printf("%-40s %8.2f ns/call\n", "TDA7419::setSpeakerVolume", speakerNs);
+        std::printf("driver setters also maintain the dirty mask (modifyRegister)\n");
+    }
+}
+
+int main() {
+    Serial.enabled = false;
+    Wire.begin();
+
+    std::printf("sizeof(TDA7419) = %zu bytes\n", sizeof(Device));
+
+    benchSetters();
+    benchFullWrites();
+    const bool transactionsOk = benchTransactions();
+    benchPoll();
+    const bool scrubOk = benchScrub();
+    const bool fadeOk = benchFade();
+    const bool coalescerOk = benchCoalescer();
+    const bool priorityOk = benchPriority();
+    const bool switchOk = benchSourceSwitch();
+    const bool stateOk = benchState();
+    const bool protocolOk = benchProtocol();
+    const bool plannerOk = benchGainPlanner();
+    const bool loudnessOk = benchLoudness();
+    const bool responseOk = benchResponse();
+    const bool groupOk = benchGroup();
+    const bool presetsOk = benchPresets();
+    const bool recoveryOk = benchRecovery();
+    benchStats();
+    benchSpectrum();
+    benchFieldAccess();
+
+    return transactionsOk && scrubOk && fadeOk && coalescerOk && protocolOk && loudnessOk && responseOk && groupOk && presetsOk && recoveryOk && priorityOk && plannerOk && switchOk && stateOk ? 0 : 1;
+}
@@ -0,0 +1,125 @@
+// Bus submissions per flush with and without batched bursts.
+// Built with the RecordingBus backend: make -C extras/host run
+// On a Linux board, pass an i2c-dev node with a TDA7419 attached to replay the
+// recorded flushes through LinuxI2CBus: build/tda7419_bus_bench /dev/i2c-1
+
+#include <tda7419.hpp>
+#include <Arduino.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+    using Device = TDA7419::TDA7419;
+
+    struct Workload {
+        const char* name;
+        void (*apply)(Device& dev);
+    };
+
+    const Workload workloads[] = {
+        { "master volume", [](Device& d) { d.setMasterVolume(-10); } },
+        { "volume + tone + subwoofer", [](Device& d) {
+            d.setMasterVolume(-10);
+            d.setBassLevel(4);
+            d.setSpeakerVolume(TDA7419::SpeakerChannel::LeftFront, -3);
+            d.setSubwooferVolume(-6);
+        } },
+        { "source + loudness + mixing", [](Device& d) {
+            d.setMainSource(TDA7419::InputSource::SE1);
+            d.setLoudnessAttenuation(5);
+            d.setSecondSource(TDA7419::InputSource::SE3);
+            d.setMixingEnable(true);
+            d.setSpectrumFilterQ(TDA7419::SpectrumFilterQ::Q1_75);
+        } },
+    };
+
+    RecordingBus record(const Workload& workload, bool batching) {
+        RecordingBus bus;
+        bus.batching = batching;
+        Device dev(bus);
+        dev.begin();
+        dev.getBus().log.clear();
+        workload.apply(dev);
+        dev.sendChangedRegisters();
+        return dev.getBus();
+    }
+
+    // Cost of entering the kernel once on this machine (write(2) to /dev/null)
+    double syscallNanos() {
+        const int fd = ::open("/dev/null", O_WRONLY);
+        const uint8_t byte = 0;
+        constexpr int iterations = 200000;
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            if (::write(fd, &byte, 1) != 1) {
+                break;
+            }
+        }
+        const auto end = std::chrono::steady_clock::now();
+        ::close(fd);
+        return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+    }
+
+    // Replay recorded flushes on real hardware, one ioctl per burst vs one per flush
+    void replay(const char* path) {
+        const int fd = TDA7419::LinuxI2CBus::open(path);
+        if (fd < 0) {
+            std::perror(path);
+            return;
+        }
+
+        std::printf("\nReplay on %s (wall clock, 100 flushes each)\n", path);
+        std::printf("%-28s %12s %12s\n", "workload", "per-burst us", "batched us");
+        for (const Workload& workload : workloads) {
+            const RecordingBus recorded = record(workload, true);
+            std::vector<TDA7419::BusMessage> messages;
+            for (const auto& burst : recorded.log.front().messages) {
+                messages.push_back({ burst.data(), static_cast<uint8_t>(burst.size()) });
+            }
+            uint8_t status[TDA7419::REGISTER_COUNT];
+
+            TDA7419::LinuxI2CBus bus(fd);
+            const auto t0 = std::chrono::steady_clock::now();
+            for (int i = 0; i < 100; ++i) {
+                for (const TDA7419::BusMessage& m : messages) {
+                    bus.write(TDA7419::TDA7419_I2C_ADDRESS, m.data, m.length);
+                }
+            }
+            const auto t1 = std::chrono::steady_clock::now();
+            for (int i = 0; i < 100; ++i) {
+                bus.writeBatch(TDA7419::TDA7419_I2C_ADDRESS, messages.data(), static_cast<uint8_t>(messages.size()), status);
+            }
+            const auto t2 = std::chrono::steady_clock::now();
+
+            std::printf("%-28s %12.1f %12.1f\n", workload.name,
+                std::chrono::duration<double, std::micro>(t1 - t0).count() / 100,
+                std::chrono::duration<double, std::micro>(t2 - t1).count() / 100);
+        }
+        ::close(fd);
+    }
+}
+
+int main(int argc, char** argv) {
+    Serial.enabled = false;
+
+    const double syscall = syscallNanos();
+    std::printf("\nBus submissions per sendChangedRegisters() (one system call each on i2c-dev)\n");
+    std::printf("syscall floor on this host: %.0f ns\n", syscall);
+    std::printf("%-28s %7s %12s %12s %17s\n", "workload", "bursts", "per-burst", "batched", "syscall ns saved");
+    for (const Workload& workload : workloads) {
+        const RecordingBus single = record(workload, false);
+        const RecordingBus batched = record(workload, true);
+        std::printf("%-28s %7zu %12zu %12zu %17.0f\n", workload.name, batched.messageCount(),
+            single.log.size(), batched.log.size(), (single.log.size() - batched.log.size()) * syscall);
+    }
+
+    if (argc > 1) {
+        replay(argv[1]);
+    }
+
+    return 0;
+}
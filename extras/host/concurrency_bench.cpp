@@ -0,0 +1,275 @@
+// Concurrent setters against a single flusher thread.
+// Built with TDA7419_CONCURRENT: make -C extras/host run
+// Under ThreadSanitizer:          make -C extras/host tsan
+//
+// Three setter threads (standing in for an encoder ISR, a BLE task and a UI task)
+// hammer fields that share registers while one thread flushes. Afterwards every
+// setter's last value must be in the shadow, and the register image seen by the
+// chip (replayed from the recorded I2C traffic) must equal the shadow.
+//
+// A second run has a writer set all four speaker volumes to one value, getting
+// preempted halfway, and counts the flushes that left the chip with mixed volumes:
+// once flushing the shadow directly, once through ImagePublisher.
+
+#include <Wire.h>
+#include <tda7419.hpp>
+#include <tda7419Publisher.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+    using Device = TDA7419::TDA7419;
+    using TDA7419::SpeakerChannel;
+
+    constexpr uint8_t SETTER_THREADS = 3;
+
+    // registers as last written to the chip
+    TDA7419::RegisterImage chip{};
+
+    void replayTraffic() {
+        for (const I2CTransaction& t : Wire.transactions()) {
+            if (t.result != 0 || t.data.empty()) {
+                continue;
+            }
+            uint8_t reg = t.data[0] & 0x1F;
+            const bool autoIncrement = (t.data[0] & TDA7419::SUBADDR_AUTO_INCREMENT_BIT) != 0;
+            for (size_t i = 1; i < t.data.size() && reg < TDA7419::REGISTER_COUNT; ++i) {
+                chip[reg] = t.data[i];
+                if (autoIncrement) {
+                    ++reg;
+                }
+            }
+        }
+        Wire.clearLog();
+    }
+
+    int8_t volumeAt(uint32_t i) { return static_cast<int8_t>(-static_cast<int32_t>(i % 80)); }
+    bool softStepAt(uint32_t i) { return (i & 1) != 0; }
+    uint8_t gainAt(uint32_t i) { return static_cast<uint8_t>(i % 16); }
+    TDA7419::InputSource sourceAt(uint32_t i) { return static_cast<TDA7419::InputSource>(i % 4); }
+
+    // setter thread t, iteration i; threads share registers 0, 3 and 10..13
+    void applySetters(Device& dev, uint8_t t, uint32_t i) {
+        switch (t) {
+        case 0:     // encoder: volume bits of register 3
+            dev.setMasterVolume(volumeAt(i));
+            break;
+        case 1:     // BLE: soft-step bits of registers 3 and 10..13, gain bits of register 0
+            dev.setMasterVolumeSoftStep(softStepAt(i));
+            for (uint8_t ch = 0; ch < 4; ++ch) {
+                dev.setSpeakerSoftStep(static_cast<SpeakerChannel>(ch), softStepAt(i + ch));
+            }
+            dev.setInputGain(gainAt(i));
+            break;
+        default:    // UI: volume bits of registers 10..13, source bits of register 0
+            for (uint8_t ch = 0; ch < 4; ++ch) {
+                dev.setSpeakerVolume(static_cast<SpeakerChannel>(ch), volumeAt(i + ch));
+            }
+            dev.setMainSource(sourceAt(i));
+            break;
+        }
+    }
+
+    bool lastValuesKept(const Device& dev, uint32_t last) {
+        bool ok = dev.getMasterVolume() == volumeAt(last) &&
+            dev.getMasterVolumeSoftStep() == softStepAt(last) &&
+            dev.getInputGain() == gainAt(last) &&
+            dev.getMainSource() == sourceAt(last);
+        for (uint8_t ch = 0; ch < 4; ++ch) {
+            const SpeakerChannel channel = static_cast<SpeakerChannel>(ch);
+            ok = ok && dev.getSpeakerSoftStep(channel) == softStepAt(last + ch) &&
+                dev.getSpeakerVolume(channel) == volumeAt(last + ch);
+        }
+        return ok;
+    }
+
+    struct Result {
+        double setterOpsPerSecond;
+        uint32_t blockedSetters;
+        uint32_t flushes;
+        bool ok;
+    };
+
+    // locked: the pre-TDA7419_CONCURRENT scheme, one mutex around every setter and flush
+    Result run(uint32_t iterations, bool locked) {
+        Device dev;
+        Wire.clearLog();
+        chip = TDA7419::RegisterImage{};
+        dev.begin();
+        replayTraffic();
+
+        std::mutex busy;
+        std::atomic<bool> done{ false };
+        std::atomic<uint32_t> blocked{ 0 };
+        uint32_t flushes = 0;
+
+        std::thread flusher([&] {
+            while (!done.load(std::memory_order_acquire)) {
+                {
+                    std::unique_lock<std::mutex> lock(busy, std::defer_lock);
+                    if (locked) {
+                        lock.lock();
+                    }
+                    // alternate the batched flush and the per-run poll() path
+                    if (flushes & 1) {
+                        dev.poll(100000);
+                    }
+                    else {
+                        dev.sendChangedRegisters();
+                    }
+                }
+                replayTraffic();
+                ++flushes;
+            }
+        });
+
+        const auto start = std::chrono::steady_clock::now();
+        std::thread setters[SETTER_THREADS];
+        for (uint8_t t = 0; t < SETTER_THREADS; ++t) {
+            setters[t] = std::thread([&, t] {
+                for (uint32_t i = 0; i < iterations; ++i) {
+                    std::unique_lock<std::mutex> lock(busy, std::defer_lock);
+                    // a setter that finds the lock taken would have to wait (or be dropped, in an ISR)
+                    if (locked && !lock.try_lock()) {
+                        blocked.fetch_add(1, std::memory_order_relaxed);
+                        lock.lock();
+                    }
+                    applySetters(dev, t, i);
+                }
+            });
+        }
+        for (std::thread& setter : setters) {
+            setter.join();
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        done.store(true, std::memory_order_release);
+        flusher.join();
+
+        // whatever the last flush raced with goes out now
+        dev.sendChangedRegisters();
+        replayTraffic();
+
+        TDA7419::RegisterImage shadow;
+        dev.getRegisterImage(shadow);
+        const bool ok = lastValuesKept(dev, iterations - 1) && shadow == chip && !dev.isFlushPending();
+
+        return Result{ SETTER_THREADS * static_cast<double>(iterations) / seconds, blocked.load(), flushes, ok };
+    }
+
+    struct TornResult {
+        uint32_t flushes;
+        uint32_t torn;
+        bool ok;
+    };
+
+    bool speakersTorn() {
+        const uint8_t level = chip[TDA7419::REG_SPEAKER_LF_LEVEL] & 0x7F;
+        for (uint8_t ch = 1; ch < 4; ++ch) {
+            if ((chip[TDA7419::REG_SPEAKER_LF_LEVEL + ch] & 0x7F) != level) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    TornResult runGroups(uint32_t iterations, bool published) {
+        Device dev;
+        Wire.clearLog();
+        chip = TDA7419::RegisterImage{};
+        dev.begin();
+        replayTraffic();
+        TDA7419::ImagePublisher publisher(dev);
+
+        std::atomic<bool> done{ false };
+        TornResult result{ 0, 0, true };
+
+        std::thread flusher([&] {
+            while (!done.load(std::memory_order_acquire)) {
+                if (published) {
+                    publisher.update();
+                }
+                else {
+                    dev.sendChangedRegisters();
+                }
+                replayTraffic();
+                ++result.flushes;
+                result.torn += speakersTorn();
+                // a flusher task sleeps between flushes
+                std::this_thread::yield();
+            }
+        });
+
+        std::thread writer([&] {
+            for (uint32_t i = 0; i < iterations; ++i) {
+                for (uint8_t ch = 0; ch < 4; ++ch) {
+                    dev.setSpeakerVolume(static_cast<SpeakerChannel>(ch), volumeAt(i));
+                    if (ch == 1) {
+                        // preempted halfway through the group
+                        std::this_thread::yield();
+                    }
+                }
+                if (published) {
+                    publisher.publish();
+                }
+            }
+        });
+
+        writer.join();
+        done.store(true, std::memory_order_release);
+        flusher.join();
+
+        if (published) {
+            publisher.update();
+        }
+        else {
+            dev.sendChangedRegisters();
+        }
+        replayTraffic();
+
+        TDA7419::RegisterImage shadow;
+        dev.getRegisterImage(shadow);
+        result.ok = shadow == chip && !speakersTorn() && !dev.isFlushPending() &&
+            (!published || (publisher.getPendingMask() == 0 && publisher.getAcknowledged() == chip));
+        return result;
+    }
+
+}
+
+int main(int argc, char** argv) {
+    Serial.enabled = false;
+    Wire.begin();
+
+    const uint32_t iterations = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 200000;
+
+    std::printf("\n== Concurrent setters, %u setter threads + 1 flusher, %u iterations each ==\n",
+        SETTER_THREADS, static_cast<unsigned>(iterations));
+    std::printf("%-12s %14s %15s %9s %8s\n", "scheme", "setter calls/s", "blocked calls", "flushes", "check");
+
+    bool ok = true;
+    for (const bool locked : { true, false }) {
+        const Result r = run(iterations, locked);
+        std::printf("%-12s %14.0f %15u %9u %8s\n", locked ? "mutex" : "lock-free",
+            r.setterOpsPerSecond, static_cast<unsigned>(r.blockedSetters), static_cast<unsigned>(r.flushes), r.ok ? "ok" : "FAIL");
+        ok = ok && r.ok;
+    }
+
+    std::printf("\n== Four-register groups, writer preempted mid-group, %u groups ==\n", static_cast<unsigned>(iterations));
+    std::printf("%-16s %9s %13s %8s\n", "flush from", "flushes", "torn images", "check");
+    for (const bool published : { false, true }) {
+        const TornResult r = runGroups(iterations, published);
+        // only the published image promises whole groups
+        const bool groupsOk = r.ok && (!published || r.torn == 0);
+        std::printf("%-16s %9u %13u %8s\n", published ? "ImagePublisher" : "shadow",
+            static_cast<unsigned>(r.flushes), static_cast<unsigned>(r.torn), groupsOk ? "ok" : "FAIL");
+        ok = ok && groupsOk;
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,20 @@
+// Code generated for grouped TDA7419Ctrl calls vs direct TDA7419 calls.
+// Inspect with: make -C extras/host codegen
+
+#include <tda7419.hpp>
+#include <tda7419Ctrl.hpp>
+
+using TDA7419::TDA7419Ctrl;
+
+extern "C" {
+    void directSetTreble(TDA7419::TDA7419& dev, int8_t level) { dev.setTrebleLevel(level); }
+    void ctrlSetTreble(TDA7419Ctrl ctrl, int8_t level) { ctrl.treble().setGain(level); }
+
+    int8_t directGetSpeaker(const TDA7419::TDA7419& dev) { return dev.getSpeakerVolume(TDA7419::SpeakerChannel::RightRear); }
+    int8_t ctrlGetSpeaker(TDA7419Ctrl ctrl) { return ctrl.speaker().getVolume(TDA7419::SpeakerChannel::RightRear); }
+
+    TDA7419::i2cResult directFlush(TDA7419::TDA7419& dev) { return dev.sendChangedRegisters(); }
+    TDA7419::i2cResult ctrlFlush(TDA7419Ctrl ctrl) { return ctrl.i2c().sendChangedRegisters(); }
+
+    unsigned ctrlSize() { return sizeof(TDA7419Ctrl); }
+}
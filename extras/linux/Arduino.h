@@ -0,0 +1,36 @@
+#pragma once
+// POSIX stand-in for the Arduino core, to run the library on Linux (e.g. a Raspberry Pi
+// driving the chip through LinuxI2CBus). Unlike the host mock, time is real:
+// micros()/millis() read CLOCK_MONOTONIC and the delays sleep with nanosleep().
+// Put this directory, not extras/host, on the include path; Wire.h is not needed.
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include "../host/HostSerial.h"
+
+#define F(str) (str)
+#define PROGMEM
+#define pgm_read_byte(addr) (*reinterpret_cast<const uint8_t*>(addr))
+#define pgm_read_dword(addr) (*reinterpret_cast<const uint32_t*>(addr))
+
+namespace posixClock {
+    inline uint64_t nanos() {
+        timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return static_cast<uint64_t>(now.tv_sec) * 1000000000u + static_cast<uint64_t>(now.tv_nsec);
+    }
+
+    // sleeps the full time even if a signal interrupts it
+    inline void sleepNanos(uint64_t ns) {
+        timespec left = { static_cast<time_t>(ns / 1000000000u), static_cast<long>(ns % 1000000000u) };
+        while (nanosleep(&left, &left) != 0 && errno == EINTR) {
+        }
+    }
+}
+
+inline unsigned long micros() { return static_cast<unsigned long>(posixClock::nanos() / 1000u); }
+inline unsigned long millis() { return static_cast<unsigned long>(posixClock::nanos() / 1000000u); }
+inline void delayMicroseconds(unsigned int us) { posixClock::sleepNanos(static_cast<uint64_t>(us) * 1000u); }
+inline void delay(unsigned long ms) { posixClock::sleepNanos(static_cast<uint64_t>(ms) * 1000000u); }
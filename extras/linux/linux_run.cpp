@@ -0,0 +1,76 @@
+// The driver on Linux: LinuxI2CBus for the bus and the POSIX shim in this directory for
+// the Arduino core (real time, no Wire.h). Built and run by make -C extras/host run.
+// Without an argument no adapter is opened, so every transfer fails; the run checks that
+// failures are reported, nothing is lost and the retry waits really sleep. Pass an i2c-dev
+// node with a TDA7419 attached to drive the chip instead: build/tda7419_linux /dev/i2c-1
+
+#include <tda7419.hpp>
+#include <Arduino.h>
+
+#include <cstdio>
+#include <unistd.h>
+
+namespace {
+
+    using Device = TDA7419::TDA7419;
+
+    // No adapter: the failed bursts stay pending, blocking retries sleep, poll() keeps its budget
+    bool runWithoutAdapter() {
+        Device dev;
+        dev.begin();
+        const bool pending = dev.isFlushPending();
+
+        TDA7419::RetryPolicy retry;
+        retry.maxAttempts = 3;
+        retry.initialBackoffMicros = 500;
+        dev.setRetryPolicy(retry);
+
+        dev.setMasterVolume(-20);
+        unsigned long start = micros();
+        const TDA7419::i2cResult blocking = dev.sendChangedRegisters();
+        const unsigned long blockingMicros = micros() - start;
+
+        retry.initialBackoffMicros = 5000;
+        dev.setRetryPolicy(retry);
+        start = micros();
+        const TDA7419::i2cResult polled = dev.poll(1000);
+        const unsigned long pollMicros = micros() - start;
+
+        const bool ok = pending && blocking == TDA7419::i2cResult::OtherError && blockingMicros >= 1500 &&
+            polled == TDA7419::i2cResult::OtherError && pollMicros < 5000 && dev.isFlushPending();
+        std::printf("no adapter: flush %u after %lu us of retries, poll(1000) %u after %lu us, still pending: %s; check: %s\n",
+            static_cast<unsigned>(blocking), blockingMicros, static_cast<unsigned>(polled), pollMicros,
+            dev.isFlushPending() ? "yes" : "no", ok ? "ok" : "FAIL");
+        return ok;
+    }
+
+    bool runOnAdapter(const char* path) {
+        const int fd = TDA7419::LinuxI2CBus::open(path);
+        if (fd < 0) {
+            std::perror(path);
+            return false;
+        }
+
+        Device dev{ TDA7419::LinuxI2CBus(fd) };
+        dev.begin();
+        dev.setMasterVolume(-20);
+        dev.setBassLevel(3);
+        const unsigned long start = micros();
+        const TDA7419::i2cResult result = dev.sendChangedRegisters();
+        const unsigned long flushMicros = micros() - start;
+        ::close(fd);
+
+        const bool ok = result == TDA7419::i2cResult::OK && !dev.isFlushPending();
+        std::printf("%s: flush %u in %lu us over %u ioctl calls; check: %s\n", path, static_cast<unsigned>(result),
+            flushMicros, static_cast<unsigned>(dev.getBus().getSubmissionCount()), ok ? "ok" : "FAIL");
+        return ok;
+    }
+}
+
+int main(int argc, char** argv) {
+    Serial.enabled = false;
+
+    std::printf("\nLinuxI2CBus with the POSIX Arduino shim (real time)\n");
+    const bool ok = argc > 1 ? runOnAdapter(argv[1]) : runWithoutAdapter();
+    return ok ? 0 : 1;
+}
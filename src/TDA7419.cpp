@@ -26,44 +26,78 @@ namespace TDA7419 {
         }
     }
 
-    // Construct with an I2C interface (defaults to Wire)
-    TDA7419::TDA7419(TwoWire& wire) : i2c(wire) {
-
-        registers[REG_MAIN_SOURCE].setValue(0x1A);          // Register 0
-        registers[REG_LOUDNESS_CONTROL].setValue(0x08);          // Register 1
-        registers[REG_SOFT_MUTE_CONTROL].setValue(0xB7);          // Register 2
-        registers[REG_MASTER_VOLUME].setValue(0x00);          // Register 3
-        registers[REG_TREBLE_FILTER].setValue(0x80);          // Register 4
-        registers[REG_MIDDLE_FILTER].setValue(0x00);          // Register 5
-        registers[REG_BASS_FILTER].setValue(0x00);          // Register 6
-        registers[REG_SECOND_SOURCE].setValue(0x41);          // Register 7
-        registers[REG_SUB_MID_BASS].setValue(0xE0);          // Register 8
-        registers[REG_MIXING_CONTROL].setValue(0x27);          // Register 9
-        registers[REG_SPEAKER_LF_LEVEL].setValue(0x00);          // Register 10
-        registers[REG_SPEAKER_RF_LEVEL].setValue(0x00);          // Register 11
-        registers[REG_SPEAKER_LR_LEVEL].setValue(0x00);          // Register 12
-        registers[REG_SPEAKER_RR_LEVEL].setValue(0x00);          // Register 13
-        registers[REG_MIXING_LEVEL].setValue(0x00);          // Register 14
-        registers[REG_SUBWOOFER_LEVEL].setValue(0x00);          // Register 15
-        registers[REG_SPECTRUM_ANALYZER].setValue(0x1C);          // Register 16
+    // Construct with a bus backend (defaults to Wire)
+    TDA7419::TDA7419(Bus bus, uint8_t address) : bus(bus), i2cAddress(address) {
+
+        registers[REG_MAIN_SOURCE] = 0x1A;               // Register 0
+        registers[REG_LOUDNESS_CONTROL] = 0x08;               // Register 1
+        registers[REG_SOFT_MUTE_CONTROL] = 0xB7;               // Register 2
+        registers[REG_MASTER_VOLUME] = 0x00;               // Register 3
+        registers[REG_TREBLE_FILTER] = 0x80;               // Register 4
+        registers[REG_MIDDLE_FILTER] = 0x00;               // Register 5
+        registers[REG_BASS_FILTER] = 0x00;               // Register 6
+        registers[REG_SECOND_SOURCE] = 0x41;               // Register 7
+        registers[REG_SUB_MID_BASS] = 0xE0;               // Register 8
+        registers[REG_MIXING_CONTROL] = 0x27;               // Register 9
+        registers[REG_SPEAKER_LF_LEVEL] = 0x00;               // Register 10
+        registers[REG_SPEAKER_RF_LEVEL] = 0x00;               // Register 11
+        registers[REG_SPEAKER_LR_LEVEL] = 0x00;               // Register 12
+        registers[REG_SPEAKER_RR_LEVEL] = 0x00;               // Register 13
+        registers[REG_MIXING_LEVEL] = 0x00;               // Register 14
+        registers[REG_SUBWOOFER_LEVEL] = 0x00;               // Register 15
+        registers[REG_SPECTRUM_ANALYZER] = 0x1C;               // Register 16
+
+        // nothing has been sent yet: every register is pending
+        dirtyMask = ALL_REGISTERS_MASK | INPUT_CHANGED_FLAG;
 
         //sendAllRegisters();
     }
 
     TDA7419::~TDA7419() = default;
 
+    void TDA7419::modifyRegister(uint8_t regIndex, uint8_t mask, uint8_t bits, uint32_t flags) {
+        uint8_t current = shadow::load(registers[regIndex]);
+        uint8_t next;
+        do {
+            next = static_cast<uint8_t>((current & ~mask) | bits);
+            if (next == current) {
+                break;
+            }
+        } while (!shadow::compareExchange(registers[regIndex], current, next));
+
+        // the register is published before its dirty bit, so a flusher that claims the bit sees the value
+        if (next != current) {
+            flags |= registerRangeMask(regIndex, 1);
+        }
+        if (flags != 0) {
+            shadow::fetchOr(dirtyMask, flags);
+        }
+    }
+
+    uint32_t TDA7419::claimDirty(uint32_t registerMask) {
+        uint32_t current = shadow::load(dirtyMask);
+        uint32_t claimed;
+        do {
+            claimed = current & registerMask;
+            if (claimed & registerRangeMask(REG_MAIN_SOURCE, 1)) {
+                claimed |= current & INPUT_CHANGED_FLAG;
+            }
+        } while (!shadow::compareExchange(dirtyMask, current, current & ~claimed));
+
+        return claimed;
+    }
+
     void TDA7419::begin() {
         sendAllRegisters();
     }
 
     // Main source selector. Register: 0, Bits: 0-2
     void TDA7419::setMainSource(InputSource source) {
-        registers[REG_MAIN_SOURCE].writeValueAtBit(0, static_cast<uint8_t>(source), 3);
-        inputChanged = true;
+        writeField<Fields::MainSource>(static_cast<uint8_t>(source), 0, INPUT_CHANGED_FLAG);
     }
 
     InputSource TDA7419::getMainSource() const {
-        return static_cast<InputSource>(registers[REG_MAIN_SOURCE].readValueAtBit(0, 3));
+        return static_cast<InputSource>(readField<Fields::MainSource>());
     }
 
     // Main input gain (clamped). Register: 0, Bits: 3-6
@@ -74,30 +108,29 @@ namespace TDA7419 {
             DEBUG_PRINT("Input gain is clamped from %d to %d\n", gain, clampedGain);
         }
 #endif
-        registers[REG_MAIN_SOURCE].writeValueAtBit(3, clampedGain, 4);
+        writeField<Fields::InputGain>(clampedGain);
     }
 
     uint8_t TDA7419::getInputGain() const {
-        return registers[REG_MAIN_SOURCE].readValueAtBit(3, 4);
+        return readField<Fields::InputGain>();
     }
 
     // Rear speaker source. Register: 7, Bit: 7
     void TDA7419::setRearSpeakerSource(RearSpeakerSource source) {
-        registers[REG_SECOND_SOURCE].writeValueAtBit(7, static_cast<uint8_t>(source), 1);
-        inputChanged = true;
+        writeField<Fields::RearSpeakerSource>(static_cast<uint8_t>(source), 0, INPUT_CHANGED_FLAG);
     }
 
     RearSpeakerSource TDA7419::getRearSpeakerSource() const {
-        return static_cast<RearSpeakerSource>(registers[REG_SECOND_SOURCE].readValueAtBit(7, 1));
+        return static_cast<RearSpeakerSource>(readField<Fields::RearSpeakerSource>());
     }
 
     // Second input source selector. Register: 7, Bits: 0-2
     void TDA7419::setSecondSource(InputSource source) {
-        registers[REG_SECOND_SOURCE].writeValueAtBit(0, static_cast<uint8_t>(source), 3);
+        writeField<Fields::SecondSource>(static_cast<uint8_t>(source));
     }
 
     InputSource TDA7419::getSecondSource() const {
-        return static_cast<InputSource>(registers[REG_SECOND_SOURCE].readValueAtBit(0, 3));
+        return static_cast<InputSource>(readField<Fields::SecondSource>());
     }
 
     // Second source input gain (clamped). Register: 7, Bits: 3-6
@@ -109,20 +142,20 @@ namespace TDA7419 {
         }
 #endif
 
-        registers[REG_SECOND_SOURCE].writeValueAtBit(3, clampedGain, 4);
+        writeField<Fields::SecondSourceInputGain>(clampedGain);
     }
 
     uint8_t TDA7419::getSecondSourceInputGain() const {
-        return registers[REG_SECOND_SOURCE].readValueAtBit(3, 4);
+        return readField<Fields::SecondSourceInputGain>();
     }
 
     // AutoZero enable/disable. Register: 0, Bit: 7
     void TDA7419::setAutoZero(bool enable) {
-        registers[REG_MAIN_SOURCE].writeValueAtBit(7, enable ? 1u : 0u, 1);
+        writeField<Fields::AutoZero>(enable ? 1u : 0u);
     }
 
     bool TDA7419::getAutoZero() const {
-        return registers[REG_MAIN_SOURCE].readValueAtBit(7, 1) != 0;
+        return readField<Fields::AutoZero>() != 0;
     }
 
     // Main loudness attenuation control (4-bit). Register: 1, Bits: 0-3
@@ -134,92 +167,92 @@ namespace TDA7419 {
         }
 #endif
 
-        registers[REG_LOUDNESS_CONTROL].writeValueAtBit(0, clampedAttenuation, 4);
+        writeField<Fields::LoudnessAttenuation>(clampedAttenuation);
     }
 
     uint8_t TDA7419::getLoudnessAttenuation() const {
-        return registers[REG_LOUDNESS_CONTROL].readValueAtBit(0, 4);
+        return readField<Fields::LoudnessAttenuation>();
     }
 
     // Loudness center frequency. Register: 1, Bits: 4-5
     void TDA7419::setLoudnessCenterFreq(LoudnessCenterFreq freq) {
-        registers[REG_LOUDNESS_CONTROL].writeValueAtBit(4, static_cast<uint8_t>(freq), 2);
+        writeField<Fields::LoudnessCenterFreq>(static_cast<uint8_t>(freq));
     }
 
     LoudnessCenterFreq TDA7419::getLoudnessCenterFreq() const {
-        return static_cast<LoudnessCenterFreq>(registers[REG_LOUDNESS_CONTROL].readValueAtBit(4, 2));
+        return static_cast<LoudnessCenterFreq>(readField<Fields::LoudnessCenterFreq>());
     }
 
     // Loudness high boost enable/disable. Register: 1, Bit: 6
     void TDA7419::setLoudnessHighBoost(bool enable) {
-        registers[REG_LOUDNESS_CONTROL].writeValueAtBit(6, enable ? 1u : 0u, 1);
+        writeField<Fields::LoudnessHighBoost>(enable ? 1u : 0u);
     }
 
     bool TDA7419::getLoudnessHighBoost() const {
-        return registers[REG_LOUDNESS_CONTROL].readValueAtBit(6, 1) != 0;
+        return readField<Fields::LoudnessHighBoost>() != 0;
     }
 
     // Loudness soft-step enable/disable. Register: 1, Bit: 7
     void TDA7419::setLoudnessSoftStep(bool enable) {
-        registers[REG_LOUDNESS_CONTROL].writeValueAtBit(7, enable ? 1u : 0u, 1);
+        writeField<Fields::LoudnessSoftStep>(enable ? 1u : 0u);
     }
 
     bool TDA7419::getLoudnessSoftStep() const {
-        return registers[REG_LOUDNESS_CONTROL].readValueAtBit(7, 1) != 0;
+        return readField<Fields::LoudnessSoftStep>() != 0;
     }
 
     // Soft-mute enable/disable. Register: 2, Bit: 0
     void TDA7419::setSoftMute(bool enable) {
-        registers[REG_SOFT_MUTE_CONTROL].writeValueAtBit(0, enable ? 1u : 0u, 1);
+        writeField<Fields::SoftMute>(enable ? 1u : 0u);
     }
 
     bool TDA7419::getSoftMute() const {
-        return registers[REG_SOFT_MUTE_CONTROL].readValueAtBit(0, 1) != 0;
+        return readField<Fields::SoftMute>() != 0;
     }
 
     // Mute-pin enable/disable. Register: 2, Bit: 1
     void TDA7419::setMutePinEnable(bool enable) {
-        registers[REG_SOFT_MUTE_CONTROL].writeValueAtBit(1, enable ? 1u : 0u, 1);
+        writeField<Fields::MutePinEnable>(enable ? 1u : 0u);
     }
 
     bool TDA7419::getMutePinEnable() const {
-        return registers[REG_SOFT_MUTE_CONTROL].readValueAtBit(1, 1) != 0;
+        return readField<Fields::MutePinEnable>() != 0;
     }
 
     // Soft-mute time. Register: 2, Bits: 2-3
     void TDA7419::setSoftMuteTime(SoftMuteTime time) {
-        registers[REG_SOFT_MUTE_CONTROL].writeValueAtBit(2, static_cast<uint8_t>(time), 2);
+        writeField<Fields::SoftMuteTime>(static_cast<uint8_t>(time));
     }
 
     SoftMuteTime TDA7419::getSoftMuteTime() const {
-        return static_cast<SoftMuteTime>(registers[REG_SOFT_MUTE_CONTROL].readValueAtBit(2, 2));
+        return static_cast<SoftMuteTime>(readField<Fields::SoftMuteTime>());
     }
 
     // Soft-step time. Register: 2, Bits: 4-6
     void TDA7419::setSoftStepTime(SoftStepTime time) {
-        registers[REG_SOFT_MUTE_CONTROL].writeValueAtBit(4, static_cast<uint8_t>(time), 3);
+        writeField<Fields::SoftStepTime>(static_cast<uint8_t>(time));
     }
 
     SoftStepTime TDA7419::getSoftStepTime() const {
-        return static_cast<SoftStepTime>(registers[REG_SOFT_MUTE_CONTROL].readValueAtBit(4, 3));
+        return static_cast<SoftStepTime>(readField<Fields::SoftStepTime>());
     }
 
     // Fast clock mode enable/disable. Register: 2, Bit: 7
     void TDA7419::setClockFastMode(bool enable) {
-        registers[REG_SOFT_MUTE_CONTROL].writeValueAtBit(7, enable ? 1u : 0u, 1);
+        writeField<Fields::ClockFastMode>(enable ? 1u : 0u);
     }
 
     bool TDA7419::getClockFastMode() const {
-        return registers[REG_SOFT_MUTE_CONTROL].readValueAtBit(7, 1) != 0;
+        return readField<Fields::ClockFastMode>() != 0;
     }
 
     // Master volume soft-step enable/disable. Register: 3, Bit: 7
     void TDA7419::setMasterVolumeSoftStep(bool enable) {
-        registers[REG_MASTER_VOLUME].writeValueAtBit(7, enable ? 1u : 0u, 1);
+        writeField<Fields::MasterVolumeSoftStep>(enable ? 1u : 0u);
     }
 
     bool TDA7419::getMasterVolumeSoftStep() const {
-        return registers[REG_MASTER_VOLUME].readValueAtBit(7, 1) != 0;
+        return readField<Fields::MasterVolumeSoftStep>() != 0;
     }
 
     // Master volume -80 to 15 (7-bit). Register: 3, Bits: 0-6
@@ -231,11 +264,11 @@ namespace TDA7419 {
         }
 #endif
 
-        registers[REG_MASTER_VOLUME].writeValueAtBit(0, convertVolumeToRegisterValue(clampedVolume), 7);
+        writeField<Fields::MasterVolume>(convertVolumeToRegisterValue(clampedVolume));
     }
 
     int8_t TDA7419::getMasterVolume() const {
-        return convertRegisterValueToVolume(registers[REG_MASTER_VOLUME].readValueAtBit(0, 7));
+        return convertRegisterValueToVolume(readField<Fields::MasterVolume>());
     }
 
     // Treble level (5-bit). Register: 4, Bits: 0-4
@@ -247,38 +280,38 @@ namespace TDA7419 {
         }
 #endif
 
-        registers[REG_TREBLE_FILTER].writeValueAtBit(0, convertEQLevelToRegisterValue(clampedLevel), 5);
+        writeField<Fields::TrebleLevel>(convertEQLevelToRegisterValue(clampedLevel));
     }
 
     int8_t TDA7419::getTrebleLevel() const {
-        return convertRegisterValueToEQLevel(registers[REG_TREBLE_FILTER].readValueAtBit(0, 5));
+        return convertRegisterValueToEQLevel(readField<Fields::TrebleLevel>());
     }
 
     // Treble center frequency. Register: 4, Bits: 5-6
     void TDA7419::setTrebleCenterFreq(TrebleCenterFreq freq) {
-        registers[REG_TREBLE_FILTER].writeValueAtBit(5, static_cast<uint8_t>(freq), 2);
+        writeField<Fields::TrebleCenterFreq>(static_cast<uint8_t>(freq));
     }
 
     TrebleCenterFreq TDA7419::getTrebleCenterFreq() const {
-        return static_cast<TrebleCenterFreq>(registers[REG_TREBLE_FILTER].readValueAtBit(5, 2));
+        return static_cast<TrebleCenterFreq>(readField<Fields::TrebleCenterFreq>());
     }
 
     // Treble reference select (internal/external). Register: 4, Bit: 7
     void TDA7419::setTrebleReferenceInternal(bool useInternalReference) {
-        registers[REG_TREBLE_FILTER].writeValueAtBit(7, useInternalReference ? 1u : 0u, 1);
+        writeField<Fields::TrebleReferenceInternal>(useInternalReference ? 1u : 0u);
     }
 
     bool TDA7419::getTrebleReferenceInternal() const {
-        return registers[REG_TREBLE_FILTER].readValueAtBit(7, 1) != 0;
+        return readField<Fields::TrebleReferenceInternal>() != 0;
     }
 
     // Middle soft-step enable/disable. Register: 5, Bit: 7
     void TDA7419::setMiddleSoftStep(bool enable) {
-        registers[REG_MIDDLE_FILTER].writeValueAtBit(7, enable ? 1u : 0u, 1);
+        writeField<Fields::MiddleSoftStep>(enable ? 1u : 0u);
     }
 
     bool TDA7419::getMiddleSoftStepEnabled() const {
-        return registers[REG_MIDDLE_FILTER].readValueAtBit(7, 1) != 0;
+        return readField<Fields::MiddleSoftStep>() != 0;
     }
 
     // Middle gain (5-bit). Register: 5, Bits: 0-4
@@ -290,29 +323,29 @@ namespace TDA7419 {
         }
 #endif
 
-        registers[REG_MIDDLE_FILTER].writeValueAtBit(0, convertEQLevelToRegisterValue(clampedGain), 5);
+        writeField<Fields::MiddleLevel>(convertEQLevelToRegisterValue(clampedGain));
     }
 
     int8_t TDA7419::getMiddleLevel() const {
-        return convertRegisterValueToEQLevel(registers[REG_MIDDLE_FILTER].readValueAtBit(0, 5));
+        return convertRegisterValueToEQLevel(readField<Fields::MiddleLevel>());
     }
 
     // Middle Q factor. Register: 5, Bits: 5-6
     void TDA7419::setMiddleQFactor(MiddleQFactor q) {
-        registers[REG_MIDDLE_FILTER].writeValueAtBit(5, static_cast<uint8_t>(q), 2);
+        writeField<Fields::MiddleQFactor>(static_cast<uint8_t>(q));
     }
 
     MiddleQFactor TDA7419::getMiddleQFactor() const {
-        return static_cast<MiddleQFactor>(registers[REG_MIDDLE_FILTER].readValueAtBit(5, 2));
+        return static_cast<MiddleQFactor>(readField<Fields::MiddleQFactor>());
     }
 
     // Bass soft-step enable/disable. Register: 6, Bit: 7
     void TDA7419::setBassSoftStep(bool enable) {
-        registers[REG_BASS_FILTER].writeValueAtBit(7, enable ? 1u : 0u, 1);
+        writeField<Fields::BassSoftStep>(enable ? 1u : 0u);
     }
 
     bool TDA7419::getBassSoftStep() const {
-        return registers[REG_BASS_FILTER].readValueAtBit(7, 1) != 0;
+        return readField<Fields::BassSoftStep>() != 0;
     }
 
     // Bass level (-15 - +15). Register: 6, Bits: 0-4
@@ -324,121 +357,119 @@ namespace TDA7419 {
         }
 #endif
 
-        registers[REG_BASS_FILTER].writeValueAtBit(0, convertEQLevelToRegisterValue(clampedLevel), 5);
+        writeField<Fields::BassLevel>(convertEQLevelToRegisterValue(clampedLevel));
     }
 
     int8_t TDA7419::getBassLevel() const {
-        return convertRegisterValueToEQLevel(registers[REG_BASS_FILTER].readValueAtBit(0, 5));
+        return convertRegisterValueToEQLevel(readField<Fields::BassLevel>());
     }
 
     // Bass Q factor. Register: 6, Bits: 5-6
     void TDA7419::setBassQFactor(BassQFactor q) {
-        registers[REG_BASS_FILTER].writeValueAtBit(5, static_cast<uint8_t>(q), 2);
+        writeField<Fields::BassQFactor>(static_cast<uint8_t>(q));
     }
 
     BassQFactor TDA7419::getBassQFactor() const {
-        return static_cast<BassQFactor>(registers[REG_BASS_FILTER].readValueAtBit(5, 2));
+        return static_cast<BassQFactor>(readField<Fields::BassQFactor>());
     }
 
     // Smoothing filter enable/disable. Register: 8, Bit: 7
     void TDA7419::setSmoothingFilter(bool enable) {
-        registers[REG_SUB_MID_BASS].writeValueAtBit(7, enable ? 1u : 0u, 1);
+        writeField<Fields::SmoothingFilter>(enable ? 1u : 0u);
     }
 
     bool TDA7419::getSmoothingFilter() const {
-        return registers[REG_SUB_MID_BASS].readValueAtBit(7, 1) != 0;
+        return readField<Fields::SmoothingFilter>() != 0;
     }
 
     // Bass DC mode enable/disable. Register: 8, Bit: 6
     void TDA7419::setBassDcMode(bool enable) {
-        registers[REG_SUB_MID_BASS].writeValueAtBit(6, enable ? 1u : 0u, 1);
+        writeField<Fields::BassDcMode>(enable ? 1u : 0u);
     }
 
     bool TDA7419::getBassDcMode() const {
-        return registers[REG_SUB_MID_BASS].readValueAtBit(6, 1) != 0;
+        return readField<Fields::BassDcMode>() != 0;
     }
 
     // Bass center frequency. Register: 8, Bits: 4-5
     void TDA7419::setBassCenterFreq(BassCenterFreq freq) {
-        registers[REG_SUB_MID_BASS].writeValueAtBit(4, static_cast<uint8_t>(freq), 2);
+        writeField<Fields::BassCenterFreq>(static_cast<uint8_t>(freq));
     }
 
     BassCenterFreq TDA7419::getBassCenterFreq() const {
-        return static_cast<BassCenterFreq>(registers[REG_SUB_MID_BASS].readValueAtBit(4, 2));
+        return static_cast<BassCenterFreq>(readField<Fields::BassCenterFreq>());
     }
 
     // Middle center frequency. Register: 8, Bits: 2-3
     void TDA7419::setMiddleCenterFreq(MiddleCenterFreq freq) {
-        registers[REG_SUB_MID_BASS].writeValueAtBit(2, static_cast<uint8_t>(freq), 2);
+        writeField<Fields::MiddleCenterFreq>(static_cast<uint8_t>(freq));
     }
 
     MiddleCenterFreq TDA7419::getMiddleCenterFreq() const {
-        return static_cast<MiddleCenterFreq>(registers[REG_SUB_MID_BASS].readValueAtBit(2, 2));
+        return static_cast<MiddleCenterFreq>(readField<Fields::MiddleCenterFreq>());
     }
 
     // Subwoofer cutoff frequency. Register: 8, Bits: 0-1
     void TDA7419::setSubCutoffFreq(SubCutoffFreq freq) {
-        registers[REG_SUB_MID_BASS].writeValueAtBit(0, static_cast<uint8_t>(freq), 2);
+        writeField<Fields::SubCutoffFreq>(static_cast<uint8_t>(freq));
     }
 
     SubCutoffFreq TDA7419::getSubCutoffFreq() const {
-        return static_cast<SubCutoffFreq>(registers[REG_SUB_MID_BASS].readValueAtBit(0, 2));
+        return static_cast<SubCutoffFreq>(readField<Fields::SubCutoffFreq>());
     }
 
     // Mixing gain effect. Register: 9, Bits: 4-7
     void TDA7419::setMixingGainEffect(MixingGainEffect effect) {
-        registers[REG_MIXING_CONTROL].writeValueAtBit(4, static_cast<uint8_t>(effect), 4);
+        writeField<Fields::MixingGainEffect>(static_cast<uint8_t>(effect));
     }
 
     MixingGainEffect TDA7419::getMixingGainEffect() const {
-        return static_cast<MixingGainEffect>(registers[REG_MIXING_CONTROL].readValueAtBit(4, 4));
+        return static_cast<MixingGainEffect>(readField<Fields::MixingGainEffect>());
     }
 
     // Subwoofer enable/disable. Register: 9, Bit: 3
     void TDA7419::setSubwooferEnable(bool enable) {
-        registers[REG_MIXING_CONTROL].writeValueAtBit(3, enable ? 1u : 0u, 1);
+        writeField<Fields::SubwooferEnable>(enable ? 1u : 0u);
     }
 
     bool TDA7419::getSubwooferEnable() const {
-        return registers[REG_MIXING_CONTROL].readValueAtBit(3, 1) != 0;
+        return readField<Fields::SubwooferEnable>() != 0;
     }
 
     // Mixing enable/disable. Register: 9, Bit: 2
     void TDA7419::setMixingEnable(bool enable) {
-        registers[REG_MIXING_CONTROL].writeValueAtBit(2, enable ? 1u : 0u, 1);
+        writeField<Fields::MixingEnable>(enable ? 1u : 0u);
     }
 
     bool TDA7419::getMixingEnable() const {
-        return registers[REG_MIXING_CONTROL].readValueAtBit(2, 1) != 0;
+        return readField<Fields::MixingEnable>() != 0;
     }
 
     // Route mix to right front. Register: 9, Bit: 1
     void TDA7419::setMixToRightFront(bool enable) {
-        registers[REG_MIXING_CONTROL].writeValueAtBit(1, enable ? 1u : 0u, 1);
+        writeField<Fields::MixToRightFront>(enable ? 1u : 0u);
     }
 
     bool TDA7419::getMixToRightFront() const {
-        return registers[REG_MIXING_CONTROL].readValueAtBit(1, 1) != 0;
+        return readField<Fields::MixToRightFront>() != 0;
     }
 
     // Route mix to left front. Register: 9, Bit: 0
     void TDA7419::setMixToLeftFront(bool enable) {
-        registers[REG_MIXING_CONTROL].writeValueAtBit(0, enable ? 1u : 0u, 1);
+        writeField<Fields::MixToLeftFront>(enable ? 1u : 0u);
     }
 
     bool TDA7419::getMixToLeftFront() const {
-        return registers[REG_MIXING_CONTROL].readValueAtBit(0, 1) != 0;
+        return readField<Fields::MixToLeftFront>() != 0;
     }
 
     // Speaker soft-step for channel. Register: (10 + channel), Bit: 7
     void TDA7419::setSpeakerSoftStep(SpeakerChannel channel, bool enable) {
-        const uint8_t index = REG_SPEAKER_LF_LEVEL + static_cast<uint8_t>(channel);
-        registers[index].writeValueAtBit(7, enable ? 1u : 0u, 1);
+        writeField<Fields::SpeakerSoftStep>(enable ? 1u : 0u, static_cast<uint8_t>(channel));
     }
 
     bool TDA7419::getSpeakerSoftStep(SpeakerChannel channel) const {
-        const uint8_t index = REG_SPEAKER_LF_LEVEL + static_cast<uint8_t>(channel);
-        return registers[index].readValueAtBit(7, 1) != 0;
+        return readField<Fields::SpeakerSoftStep>(static_cast<uint8_t>(channel)) != 0;
     }
 
     // Speaker volume for channel (7-bit). Register: (10 + channel), Bits: 0-6
@@ -450,22 +481,20 @@ namespace TDA7419 {
         }
 #endif
 
-        const uint8_t index = REG_SPEAKER_LF_LEVEL + static_cast<uint8_t>(channel);
-        registers[index].writeValueAtBit(0, convertVolumeToRegisterValue(clampedVolume), 7);
+        writeField<Fields::SpeakerVolume>(convertVolumeToRegisterValue(clampedVolume), static_cast<uint8_t>(channel));
     }
 
     int8_t TDA7419::getSpeakerVolume(SpeakerChannel channel) const {
-        const uint8_t index = REG_SPEAKER_LF_LEVEL + static_cast<uint8_t>(channel);
-        return convertRegisterValueToVolume(registers[index].readValueAtBit(0, 7));
+        return convertRegisterValueToVolume(readField<Fields::SpeakerVolume>(static_cast<uint8_t>(channel)));
     }
 
     // Mixing channel soft-step. Register: 14, Bit: 7
     void TDA7419::setMixingChannelSoftStep(bool enable) {
-        registers[REG_MIXING_LEVEL].writeValueAtBit(7, enable ? 1u : 0u, 1);
+        writeField<Fields::MixingChannelSoftStep>(enable ? 1u : 0u);
     }
 
     bool TDA7419::getMixingChannelSoftStep() const {
-        return registers[REG_MIXING_LEVEL].readValueAtBit(7, 1) != 0;
+        return readField<Fields::MixingChannelSoftStep>() != 0;
     }
 
     // Mixing channel volume (-80 - +15). Register: 14, Bits: 0-6
@@ -476,20 +505,20 @@ namespace TDA7419 {
             DEBUG_PRINT("Mixing channel volume is clamped from %d to %d\n", volume, clampedVolume);
         }
 #endif
-        registers[REG_MIXING_LEVEL].writeValueAtBit(0, convertVolumeToRegisterValue(clampedVolume), 7);
+        writeField<Fields::MixingChannelVolume>(convertVolumeToRegisterValue(clampedVolume));
     }
 
     int8_t TDA7419::getMixingChannelVolume() const {
-        return convertRegisterValueToVolume(registers[REG_MIXING_LEVEL].readValueAtBit(0, 7));
+        return convertRegisterValueToVolume(readField<Fields::MixingChannelVolume>());
     }
 
     // Subwoofer soft-step. Register: 15, Bit: 7
     void TDA7419::setSubwooferSoftStep(bool enable) {
-        registers[REG_SUBWOOFER_LEVEL].writeValueAtBit(7, enable ? 1u : 0u, 1);
+        writeField<Fields::SubwooferSoftStep>(enable ? 1u : 0u);
     }
 
     bool TDA7419::getSubwooferSoftStep() const {
-        return registers[REG_SUBWOOFER_LEVEL].readValueAtBit(7, 1) != 0;
+        return readField<Fields::SubwooferSoftStep>() != 0;
     }
 
     // Subwoofer volume (-80 - +15). Register: 15, Bits: 0-6
@@ -501,91 +530,104 @@ namespace TDA7419 {
         }
 #endif
 
-        registers[REG_SUBWOOFER_LEVEL].writeValueAtBit(0, convertVolumeToRegisterValue(clampedVolume), 7);
+        writeField<Fields::SubwooferVolume>(convertVolumeToRegisterValue(clampedVolume));
     }
 
     int8_t TDA7419::getSubwooferVolume() const {
-        return convertRegisterValueToVolume(registers[REG_SUBWOOFER_LEVEL].readValueAtBit(0, 7));
+        return convertRegisterValueToVolume(readField<Fields::SubwooferVolume>());
     }
 
     // Spectrum coupling mode. Register: 16, Bits: 6-7
     void TDA7419::setSpectrumCouplingMode(SpectrumCouplingMode mode) {
-        registers[REG_SPECTRUM_ANALYZER].writeValueAtBit(6, static_cast<uint8_t>(mode), 2);
+        writeField<Fields::SpectrumCouplingMode>(static_cast<uint8_t>(mode));
     }
 
     SpectrumCouplingMode TDA7419::getSpectrumCouplingMode() const {
-        return static_cast<SpectrumCouplingMode>(registers[REG_SPECTRUM_ANALYZER].readValueAtBit(6, 2));
+        return static_cast<SpectrumCouplingMode>(readField<Fields::SpectrumCouplingMode>());
     }
 
     // External clock select. Register: 16, Bit: 5
     void TDA7419::setExternalClock(bool useExternal) {
-        registers[REG_SPECTRUM_ANALYZER].writeValueAtBit(5, useExternal ? 1u : 0u, 1);
+        writeField<Fields::ExternalClock>(useExternal ? 1u : 0u);
     }
 
     bool TDA7419::getExternalClock() const {
-        return registers[REG_SPECTRUM_ANALYZER].readValueAtBit(5, 1) != 0;
+        return readField<Fields::ExternalClock>() != 0;
     }
 
     // Spectrum reset. Register: 16, Bit: 4
     void TDA7419::setSpectrumReset(bool enable) {
-        registers[REG_SPECTRUM_ANALYZER].writeValueAtBit(4, enable ? 1u : 0u, 1);
+        writeField<Fields::SpectrumReset>(enable ? 1u : 0u);
     }
 
     bool TDA7419::getSpectrumReset() const {
-        return registers[REG_SPECTRUM_ANALYZER].readValueAtBit(4, 1) != 0;
+        return readField<Fields::SpectrumReset>() != 0;
     }
 
     // Spectrum run. Register: 16, Bit: 3
     void TDA7419::setSpectrumRun(bool enable) {
-        registers[REG_SPECTRUM_ANALYZER].writeValueAtBit(3, enable ? 1u : 0u, 1);
+        writeField<Fields::SpectrumRun>(enable ? 1u : 0u);
     }
 
     bool TDA7419::getSpectrumRun() const {
-        return registers[REG_SPECTRUM_ANALYZER].readValueAtBit(3, 1) != 0;
+        return readField<Fields::SpectrumRun>() != 0;
     }
 
     // Spectrum source. Register: 16, Bit: 2
     void TDA7419::setSpectrumSource(SpectrumSource source) {
-        registers[REG_SPECTRUM_ANALYZER].writeValueAtBit(2, static_cast<uint8_t>(source), 1);
+        writeField<Fields::SpectrumSource>(static_cast<uint8_t>(source));
     }
 
     SpectrumSource TDA7419::getSpectrumSource() const {
-        return static_cast<SpectrumSource>(registers[REG_SPECTRUM_ANALYZER].readValueAtBit(2, 1));
+        return static_cast<SpectrumSource>(readField<Fields::SpectrumSource>());
     }
 
     // Spectrum auto-reset enable/disable. Register: 16, Bit: 1
     void TDA7419::setSpectrumAutoReset(bool enable) {
-        registers[REG_SPECTRUM_ANALYZER].writeValueAtBit(1, enable ? 1u : 0u, 1);
+        writeField<Fields::SpectrumAutoReset>(enable ? 1u : 0u);
     }
 
     bool TDA7419::getSpectrumAutoReset() const {
-        return registers[REG_SPECTRUM_ANALYZER].readValueAtBit(1, 1) != 0;
+        return readField<Fields::SpectrumAutoReset>() != 0;
     }
 
     // Spectrum filter Q. Register: 16, Bit: 0
     void TDA7419::setSpectrumFilterQ(SpectrumFilterQ filterQ) {
-        registers[REG_SPECTRUM_ANALYZER].writeValueAtBit(0, static_cast<uint8_t>(filterQ), 1);
+        writeField<Fields::SpectrumFilterQ>(static_cast<uint8_t>(filterQ));
     }
 
     SpectrumFilterQ TDA7419::getSpectrumFilterQ() const {
-        return static_cast<SpectrumFilterQ>(registers[REG_SPECTRUM_ANALYZER].readValueAtBit(0, 1));
+        return static_cast<SpectrumFilterQ>(readField<Fields::SpectrumFilterQ>());
     }
 
     uint8_t TDA7419::getRegisterValue(uint8_t regIndex) const
     {
-        return registers[regIndex].getValue();
+        return shadow::load(registers[regIndex]);
     }
 
     void TDA7419::setRegisterValue(uint8_t regIndex, uint8_t value)
     {
-        registers[regIndex].setValue(value);
+        storeRegister(regIndex, value);
     }
 
-    inline i2cResult TDA7419::sendData(const uint8_t* data, size_t length)
+    void TDA7419::setRegisterImage(const RegisterImage& image)
     {
-        i2c.beginTransmission(TDA7419_I2C_ADDRESS);
-        i2c.write(data, length);
-        uint8_t status = i2c.endTransmission();
+        const bool sourceChanged =
+            Fields::MainSource::decode(image[REG_MAIN_SOURCE]) != readField<Fields::MainSource>() ||
+            Fields::RearSpeakerSource::decode(image[REG_SECOND_SOURCE]) != readField<Fields::RearSpeakerSource>();
+
+        for (uint8_t reg = 0; reg < REGISTER_COUNT; ++reg) {
+            storeRegister(reg, image[reg], (reg == REG_MAIN_SOURCE && sourceChanged) ? INPUT_CHANGED_FLAG : 0);
+        }
+    }
+
+    inline i2cResult TDA7419::transmit(const uint8_t* data, size_t length)
+    {
+        if (mux != nullptr) {
+            mux->select(muxChannel);
+        }
+
+        uint8_t status = bus.write(i2cAddress, data, length);
 
 #ifdef TDA7419_DEBUG
         printTransmissionError(status);
@@ -594,31 +636,195 @@ namespace TDA7419 {
         return static_cast<i2cResult>(status);
     }
 
-    inline uint8_t TDA7419::getSubAddress(uint8_t regIndex, bool autoIncrement, bool autoZeroRemain) const
+    i2cResult TDA7419::sendData(const uint8_t* data, size_t length)
+    {
+#ifdef TDA7419_STATS
+        const uint32_t start = micros();
+#endif
+
+        i2cResult result = retry(data, length, transmit(data, length));
+
+#ifdef TDA7419_STATS
+        recordTransmission(length, result, micros() - start);
+#endif
+
+        return result;
+    }
+
+    i2cResult TDA7419::retry(const uint8_t* data, size_t length, i2cResult result)
+    {
+        uint32_t backoff = retryPolicy.initialBackoffMicros;
+        for (uint8_t attempt = 1; attempt < retryPolicy.maxAttempts; ++attempt) {
+            // a buffer overflow fails the same way every time
+            if (result == i2cResult::OK || result == i2cResult::DataTooLong) {
+                break;
+            }
+
+            // inside poll() a retry that would overrun the budget is left to the next call
+            if (retryBounded) {
+                const uint32_t needed = backoff + burstMicros(static_cast<uint8_t>(length - 1));
+                if (static_cast<int32_t>(retryDeadline - micros()) < static_cast<int32_t>(needed)) {
+                    break;
+                }
+            }
+
+            // timeouts and bus errors usually mean a stuck bus: let the application recover it
+            if ((result == i2cResult::Timeout || result == i2cResult::OtherError) && busRecovery != nullptr) {
+                busRecovery(busRecoveryContext, result);
+                if (mux != nullptr) {
+                    mux->invalidate();
+                }
+            }
+
+            delayMicroseconds(backoff);
+            backoff = backoff * retryPolicy.backoffMultiplier;
+            if (backoff > retryPolicy.maxBackoffMicros) {
+                backoff = retryPolicy.maxBackoffMicros;
+            }
+
+            result = transmit(data, length);
+        }
+
+        return result;
+    }
+
+    void TDA7419::sendBatch(const BusMessage* messages, uint8_t count, i2cResult* results)
+    {
+#ifdef TDA7419_STATS
+        uint32_t start = micros();
+#endif
+
+        if (mux != nullptr) {
+            mux->select(muxChannel);
+        }
+
+        uint8_t status[REGISTER_COUNT];
+        bus.writeBatch(i2cAddress, messages, count, status);
+
+#ifdef TDA7419_STATS
+        // the submission time is shared evenly; retries are charged to their own burst
+        const uint32_t share = (micros() - start) / count;
+#endif
+
+        for (uint8_t i = 0; i < count; ++i) {
+#ifdef TDA7419_DEBUG
+            printTransmissionError(status[i]);
+#endif
+#ifdef TDA7419_STATS
+            start = micros();
+#endif
+
+            results[i] = retry(messages[i].data, messages[i].length, static_cast<i2cResult>(status[i]));
+
+#ifdef TDA7419_STATS
+            recordTransmission(messages[i].length, results[i], share + (micros() - start));
+#endif
+        }
+    }
+
+    uint8_t TDA7419::getSubAddress(uint8_t regIndex, bool autoIncrement, bool autoZeroRemain) const
     {
         return regIndex +
             (autoIncrement ? SUBADDR_AUTO_INCREMENT_BIT : 0) +
             (autoZeroRemain ? SUBADDR_AUTOZERO_REMAIN_BIT : 0);
     }
 
-    inline i2cResult TDA7419::sendRegister(uint8_t regIndex)
+    i2cResult TDA7419::sendRegister(uint8_t regIndex)
     {
-        uint8_t value[2] = { getSubAddress(regIndex, false, inputChanged), registers[regIndex].getValue() };
+        return sendRange(regIndex, 1, false);
+    }
 
-        i2cResult result = sendData(value, 2);
+    i2cResult TDA7419::sendRegisterRange(uint8_t firstIndex, uint8_t count)
+    {
+        return sendRange(firstIndex, count, false);
+    }
+
+    i2cResult TDA7419::sendRange(uint8_t firstIndex, uint8_t count, bool refresh)
+    {
+        // inside a transaction the range is queued for the outermost commit()
+        if (updateDepth > 0) {
+            shadow::fetchOr(dirtyMask, registerRangeMask(firstIndex, count));
+            return i2cResult::OK;
+        }
+
+        // a refresh rewrites the source unchanged, which must not restart AutoZero
+        const uint32_t claimed = claimDirty(registerRangeMask(firstIndex, count));
+        const bool autoZero = autoZeroRemain(claimed) || (refresh && firstIndex == REG_MAIN_SOURCE);
+        uint8_t values[REGISTER_COUNT + 1];
+        values[0] = getSubAddress(firstIndex, count > 1, autoZero);
+        for (uint8_t i = 0; i < count; ++i) {
+            values[i + 1] = shadow::load(registers[firstIndex + i]);
+        }
+
+        i2cResult result = sendData(values, count + 1);
 
         if (result == i2cResult::OK) {
-            registers[regIndex].clearChanged();
+#ifdef TDA7419_STATS
+            recordRegisterWrites(firstIndex, count);
+#endif
+        }
+        else {
+            releaseDirty(claimed);
+        }
+
+        return result;
+    }
 
-            if (regIndex == REG_MAIN_SOURCE && inputChanged) {
-                inputChanged = false;
+    uint8_t TDA7419::planChangedRuns(RegisterRun* runs, uint32_t pendingMask, uint32_t withheldMask) const
+    {
+        uint8_t runCount = 0;
+
+        // walk the set bits of the pending mask, lowest register first
+        for (uint32_t pending = pendingMask; pending != 0; pending &= pending - 1) {
+            const uint8_t reg = lowestSetBit(pending);
+
+            if (runCount > 0) {
+                RegisterRun& last = runs[runCount - 1];
+                const uint8_t lastEnd = last.first + last.count;
+                const uint8_t gap = reg - lastEnd;
+
+                // Fill the gap with unchanged registers if one burst is not more expensive than two
+                if (burstBitTimes(last.count + gap + 1) <= burstBitTimes(last.count) + burstBitTimes(1) &&
+                    (withheldMask & registerRangeMask(lastEnd, gap)) == 0) {
+                    last.count += gap + 1;
+                    continue;
+                }
             }
+
+            runs[runCount].first = reg;
+            runs[runCount].count = 1;
+            ++runCount;
         }
 
-        return result;
+        return runCount;
     }
 
+    uint8_t TDA7419::planFlush(RegisterRun* runs, uint32_t pendingMask, uint32_t withheldMask) const
+    {
+        // each pass withholds the pending registers of the other class, so no burst carries one;
+        // unchanged registers of either class may still fill a gap
+        const uint32_t urgent = pendingMask & urgentMask;
+        const uint32_t deferrable = pendingMask & ~urgentMask;
+        const uint8_t urgentCount = planChangedRuns(runs, urgent, withheldMask | deferrable);
+        return urgentCount + planChangedRuns(runs + urgentCount, deferrable, withheldMask | urgent);
+    }
 
+    void TDA7419::setRegisterPriority(uint8_t regIndex, RegisterPriority priority) {
+        if (regIndex >= REGISTER_COUNT) {
+            return;
+        }
+
+        if (priority == RegisterPriority::Urgent) {
+            urgentMask |= uint32_t(1) << regIndex;
+        }
+        else {
+            urgentMask &= ~(uint32_t(1) << regIndex);
+        }
+    }
+
+    RegisterPriority TDA7419::getRegisterPriority(uint8_t regIndex) const {
+        return (urgentMask >> regIndex) & 1 ? RegisterPriority::Urgent : RegisterPriority::Deferrable;
+    }
 
     void TDA7419::printTransmissionError(uint8_t errorCode) const
     {
@@ -657,45 +863,440 @@ namespace TDA7419 {
         DEBUG_PRINTLN("[TDA7419] Sending all registers");
 #endif
 
+        if (updateDepth > 0) {
+            queueAllRegisters();
+            return i2cResult::OK;
+        }
+
+#ifdef TDA7419_STATS
+        const uint32_t start = micros();
+#endif
+
+        const uint32_t claimed = claimDirty(ALL_REGISTERS_MASK | INPUT_CHANGED_FLAG);
         uint8_t values[REGISTER_COUNT + 1];
-        values[0] = getSubAddress(REG_MAIN_SOURCE, true, inputChanged); // subaddress starting command (document this)
+        values[0] = getSubAddress(REG_MAIN_SOURCE, true, autoZeroRemain(claimed)); // subaddress starting command (document this)
         for (uint8_t reg = 0; reg < REGISTER_COUNT; ++reg) {
-            values[reg + 1] = registers[reg].getValue();
+            values[reg + 1] = shadow::load(registers[reg]);
         }
 
         i2cResult result = sendData(values, sizeof(values));
 
         if (result == i2cResult::OK) {
+#ifdef TDA7419_STATS
+            recordRegisterWrites(0, REGISTER_COUNT);
+#endif
+        }
+        else {
             // only clear changed if transfer succeeded
-            for (uint8_t reg = 0; reg < REGISTER_COUNT; ++reg) {
-                registers[reg].clearChanged();
-            }
-
-            inputChanged = false;
+            releaseDirty(claimed);
         }
 
-        return i2cResult::OK;
+#ifdef TDA7419_STATS
+        recordFlushDuration(micros() - start);
+#endif
+
+        return result;
     }
 
-    i2cResult TDA7419::sendChangedRegisters() {
+    i2cResult TDA7419::sendChangedRegisters(uint32_t registerMask) {
 #ifdef TDA7419_DEBUG
         printRegistersDebug();
         DEBUG_PRINTLN(F("[TDA7419] Sending changed registers"));
 #endif
 
-        i2cResult result;
-        for (uint8_t reg = 0; reg < REGISTER_COUNT; ++reg) {
-            if (registers[reg].isChanged()) {
-                DEBUG_PRINT(F("[TDA7419] Sending register: %d\n"), reg);
-                result = sendRegister(reg);
+        // changes accumulate until the outermost commit()
+        if (updateDepth > 0) {
+            return i2cResult::OK;
+        }
+
+#ifdef TDA7419_STATS
+        const uint32_t start = micros();
+#endif
+
+        // claimed bits are cleared up front; a setter running meanwhile re-marks its register
+        const uint32_t claimed = claimDirty(registerMask & ALL_REGISTERS_MASK);
+        const bool autoZero = autoZeroRemain(claimed);
+
+        RegisterRun runs[REGISTER_COUNT];
+        const uint8_t runCount = planFlush(runs, claimed & ALL_REGISTERS_MASK, getDirtyMask());
+
+        i2cResult results[REGISTER_COUNT];
+        sendRuns(runs, runCount, registers.data(), autoZero, results);
+
+        // a failed run stays dirty; the others are applied so one glitch does not hold back the rest
+        i2cResult firstError = i2cResult::OK;
+        for (uint8_t i = 0; i < runCount; ++i) {
+            if (results[i] != i2cResult::OK) {
+                if (firstError == i2cResult::OK) {
+                    firstError = results[i];
+                }
+                const uint32_t runMask = registerRangeMask(runs[i].first, runs[i].count) |
+                    (runs[i].first == REG_MAIN_SOURCE ? INPUT_CHANGED_FLAG : 0);
+                releaseDirty(claimed & runMask);
+            }
+        }
+
+#ifdef TDA7419_STATS
+        if (runCount > 0) {
+            recordFlushDuration(micros() - start);
+        }
+#endif
+
+        return firstError;
+    }
+
+    i2cResult TDA7419::sendImageRegisters(const RegisterImage& image, uint32_t registerMask, bool autoZeroRemain, uint32_t& sentMask) {
+#ifdef TDA7419_STATS
+        const uint32_t start = micros();
+#endif
+
+        RegisterRun runs[REGISTER_COUNT];
+        const uint8_t runCount = planFlush(runs, registerMask & ALL_REGISTERS_MASK, 0);
+
+        i2cResult results[REGISTER_COUNT];
+        sendRuns(runs, runCount, image.data(), autoZeroRemain, results);
+
+        i2cResult firstError = i2cResult::OK;
+        sentMask = 0;
+        for (uint8_t i = 0; i < runCount; ++i) {
+            if (results[i] == i2cResult::OK) {
+                sentMask |= registerRangeMask(runs[i].first, runs[i].count);
+            }
+            else if (firstError == i2cResult::OK) {
+                firstError = results[i];
+            }
+        }
+
+#ifdef TDA7419_STATS
+        if (runCount > 0) {
+            recordFlushDuration(micros() - start);
+        }
+#endif
+
+        return firstError;
+    }
+
+    void TDA7419::acknowledgeImage(const RegisterImage& image, uint32_t registerMask) {
+        // claim before comparing: a setter running meanwhile marks its register again
+        const uint32_t claimed = claimDirty(registerMask & ALL_REGISTERS_MASK);
+        uint32_t stale = 0;
+        for (uint32_t bits = claimed & ALL_REGISTERS_MASK; bits != 0; bits &= bits - 1) {
+            const uint8_t reg = lowestSetBit(bits);
+            if (shadow::load(registers[reg]) != image[reg]) {
+                stale |= registerRangeMask(reg, 1);
+            }
+        }
+        // claimDirty() took INPUT_CHANGED_FLAG along with register 0: a stale source keeps it
+        if (stale & registerRangeMask(REG_MAIN_SOURCE, 1)) {
+            stale |= claimed & INPUT_CHANGED_FLAG;
+        }
+        releaseDirty(stale);
+    }
+
+    void TDA7419::sendRuns(const RegisterRun* runs, uint8_t runCount, const uint8_t* image, bool autoZero, i2cResult* results) {
+        // every run is a subaddress byte plus its registers
+        uint8_t buffer[2 * REGISTER_COUNT];
+        BusMessage messages[REGISTER_COUNT];
+        uint8_t used = 0;
+        for (uint8_t i = 0; i < runCount; ++i) {
+            DEBUG_PRINT(F("[TDA7419] Sending registers: %d..%d\n"), runs[i].first, runs[i].first + runs[i].count - 1);
+            messages[i].data = &buffer[used];
+            messages[i].length = runs[i].count + 1;
+
+            // a single register is sent without the auto-increment bit, as in sendRegister();
+            // the AutoZero remain bit only goes with the write of register 0
+            buffer[used++] = getSubAddress(runs[i].first, runs[i].count > 1, autoZero && runs[i].first == REG_MAIN_SOURCE);
+            for (uint8_t r = 0; r < runs[i].count; ++r) {
+                buffer[used++] = shadow::load(image[runs[i].first + r]);
+            }
+        }
+
+        if (runCount > 0) {
+            sendBatch(messages, runCount, results);
+        }
+
+#ifdef TDA7419_STATS
+        for (uint8_t i = 0; i < runCount; ++i) {
+            if (results[i] == i2cResult::OK) {
+                recordRegisterWrites(runs[i].first, runs[i].count);
+            }
+        }
+#endif
+    }
+
+    void TDA7419::beginUpdate() {
+        if (updateDepth == 0) {
+            committedRegisters = registers;
+            committedDirtyMask = shadow::load(dirtyMask);
+        }
+        ++updateDepth;
+    }
+
+    i2cResult TDA7419::commit() {
+        if (updateDepth > 0 && --updateDepth > 0) {
+            return i2cResult::OK;
+        }
+
+        return sendChangedRegisters();
+    }
+
+    void TDA7419::abort() {
+        if (updateDepth == 0) {
+            return;
+        }
+
+        registers = committedRegisters;
+        dirtyMask = committedDirtyMask;
+        updateDepth = 0;
+    }
+
+    void TDA7419::setBusMux(BusMux* busMux, uint8_t channel) {
+        mux = busMux;
+        muxChannel = channel;
+    }
+
+    void TDA7419::queueAllRegisters() {
+        shadow::fetchOr(dirtyMask, ALL_REGISTERS_MASK);
+    }
+
+    uint32_t TDA7419::burstMicros(uint8_t registerCount) const {
+        const uint32_t bits = burstBitTimes(registerCount);
+        return (bits * 1000000UL + busClockHz - 1) / busClockHz;
+    }
+
+    uint32_t TDA7419::flushMicros(uint32_t registerMask) const {
+        RegisterRun runs[REGISTER_COUNT];
+        const uint8_t runCount = planFlush(runs, registerMask & ALL_REGISTERS_MASK, 0);
+
+        uint32_t total = 0;
+        for (uint8_t i = 0; i < runCount; ++i) {
+            total += burstMicros(runs[i].count);
+        }
+        return total;
+    }
+
+    uint8_t TDA7419::registersWithinBudget(uint32_t budgetMicros, uint8_t maxCount) const {
+        // a full 17-register burst takes well under a second at any bus speed
+        if (budgetMicros > 1000000UL) {
+            budgetMicros = 1000000UL;
+        }
+
+        const uint32_t budgetBits = budgetMicros * (busClockHz / 1000) / 1000;
+        const uint32_t overheadBits = burstBitTimes(0);
+        if (budgetBits < overheadBits + I2C_BITS_PER_BYTE) {
+            return 0;
+        }
+
+        const uint32_t fits = (budgetBits - overheadBits) / I2C_BITS_PER_BYTE;
+        return fits < maxCount ? static_cast<uint8_t>(fits) : maxCount;
+    }
+
+    i2cResult TDA7419::poll(uint32_t budgetMicros, FlushReport* report) {
+        const uint32_t pending = getDirtyMask();
+        if (updateDepth > 0 || (pending == 0 && scrubPermille == 0)) {
+            return i2cResult::OK;
+        }
+
+        const uint32_t start = micros();
+        // budgets past half the clock range (e.g. 0xFFFFFFFF from TDA7419Group::flush()) would
+        // wrap the deadline and fail the signed check in retry(): treat them as unlimited
+        retryDeadline = start + budgetMicros;
+        retryBounded = budgetMicros < 0x80000000UL;
+
+        // every run claims its registers when it is sent
+        RegisterRun runs[REGISTER_COUNT];
+        const uint8_t runCount = planFlush(runs, pending, 0);
+
+        i2cResult firstError = i2cResult::OK;
+        for (uint8_t i = 0; i < runCount; ++i) {
+            const uint32_t elapsed = micros() - start;
+            if (elapsed >= budgetMicros) {
+                break;
+            }
+
+            const uint8_t count = registersWithinBudget(budgetMicros - elapsed, runs[i].count);
+            if (count == 0) {
+                break;
+            }
+
+            i2cResult result = sendRegisterRange(runs[i].first, count);
+
+            if (report != nullptr) {
+                ++report->transactions;
+                report->bytes += burstBytes(count);
                 if (result != i2cResult::OK) {
-                    return result;
+                    ++report->errors;
                 }
-                registers[reg].clearChanged();
             }
+
+            if (result != i2cResult::OK && firstError == i2cResult::OK) {
+                firstError = result;
+            }
+
+            // the rest of a split run is still dirty and goes out on the next call
+            if (count < runs[i].count) {
+                break;
+            }
+        }
+
+        // pending changes preempt the scrubber
+        if (!isFlushPending() && scrubPermille != 0) {
+            const uint32_t elapsed = micros() - start;
+            if (elapsed < budgetMicros) {
+                i2cResult result = scrub(budgetMicros - elapsed, report);
+                if (result != i2cResult::OK && firstError == i2cResult::OK) {
+                    firstError = result;
+                }
+            }
+        }
+        retryBounded = false;
+
+#ifdef TDA7419_STATS
+        if (runCount > 0) {
+            recordFlushDuration(micros() - start);
+        }
+#endif
+
+        return firstError;
+    }
+
+    void TDA7419::setScrubBudget(uint16_t permille, uint8_t sliceRegisters) {
+        if (permille > 1000) permille = 1000;
+        if (sliceRegisters < 1) sliceRegisters = 1;
+        if (sliceRegisters > REGISTER_COUNT) sliceRegisters = REGISTER_COUNT;
+
+        scrubPermille = permille;
+        scrubSlice = sliceRegisters;
+        scrubCreditMicros = 0;
+        scrubLastMicros = micros();
+    }
+
+    i2cResult TDA7419::scrub(uint32_t budgetMicros, FlushReport* report) {
+        // refill the token bucket with the configured share of the time since the last call
+        const uint32_t now = micros();
+        uint32_t elapsed = now - scrubLastMicros;
+        scrubLastMicros = now;
+        if (elapsed > 1000000UL) elapsed = 1000000UL;   // keeps elapsed * permille in 32 bits
+
+        const uint32_t depth = burstMicros(scrubSlice);
+        scrubCreditMicros += elapsed * scrubPermille / 1000;
+        if (scrubCreditMicros > depth) {
+            scrubCreditMicros = depth;
+        }
+
+        // slices do not wrap, the last one of a cycle may be shorter
+        uint8_t count = REGISTER_COUNT - scrubCursor;
+        if (count > scrubSlice) count = scrubSlice;
+        count = registersWithinBudget(budgetMicros, count);
+        if (count == 0 || scrubCreditMicros < burstMicros(count)) {
+            return i2cResult::OK;
+        }
+
+        scrubCreditMicros -= burstMicros(count);
+        i2cResult result = sendRange(scrubCursor, count, true);
+
+        if (report != nullptr) {
+            ++report->transactions;
+            ++report->scrubs;
+            report->bytes += burstBytes(count);
+            if (result != i2cResult::OK) {
+                ++report->errors;
+            }
+        }
+
+        // a failed slice is repeated when the bucket has refilled
+        if (result == i2cResult::OK) {
+            scrubCursor += count;
+            if (scrubCursor >= REGISTER_COUNT) {
+                scrubCursor = 0;
+                ++scrubCycles;
+            }
+        }
+
+        return result;
+    }
+
+    void TDA7419::setBusRecovery(BusRecoveryFn recoveryFn, void* context) {
+        busRecovery = recoveryFn;
+        busRecoveryContext = context;
+    }
+
+#ifdef TDA7419_STATS
+    void TDA7419::recordTransmission(size_t length, i2cResult result, uint32_t latencyMicros) {
+        ++busStats.transactions;
+        // device address byte + payload
+        busStats.bytesSent += length + 1;
+
+        const uint8_t code = static_cast<uint8_t>(result);
+        if (code < STATS_RESULT_CODES) {
+            ++busStats.resultCounts[code];
+        }
+
+        // bucket 0: < 64 us, then one bucket per doubling, last bucket open-ended
+        uint8_t bucket = 0;
+        for (uint32_t limit = STATS_LATENCY_FIRST_BUCKET_MICROS; latencyMicros >= limit && bucket < STATS_LATENCY_BUCKETS - 1; limit <<= 1) {
+            ++bucket;
+        }
+        ++busStats.latencyHistogram[bucket];
+    }
+
+    void TDA7419::recordRegisterWrites(uint8_t firstIndex, uint8_t count) {
+        for (uint8_t i = 0; i < count; ++i) {
+            ++busStats.registerWrites[firstIndex + i];
+        }
+    }
+
+    void TDA7419::recordFlushDuration(uint32_t durationMicros) {
+        if (durationMicros > busStats.maxFlushMicros) {
+            busStats.maxFlushMicros = durationMicros;
+        }
+    }
+
+    void TDA7419::resetBusStats() {
+        busStats = BusStats();
+    }
+
+    void TDA7419::printBusStats() const
+    {
+        Serial.println(F("\n--[ TDA7419 BUS STATS ]-----------------"));
+        Serial.print(F("Transactions: "));
+        Serial.println(busStats.transactions);
+        Serial.print(F("Bytes sent:   "));
+        Serial.println(busStats.bytesSent);
+        Serial.print(F("Max flush us: "));
+        Serial.println(busStats.maxFlushMicros);
+
+        Serial.print(F("Results (OK/TooLong/NACKAddr/NACKData/Other/Timeout):"));
+        for (uint8_t code = 0; code < STATS_RESULT_CODES; ++code) {
+            Serial.print(' ');
+            Serial.print(busStats.resultCounts[code]);
         }
-        return i2cResult::OK;
+        Serial.println();
+
+        Serial.print(F("Register writes:"));
+        for (uint8_t reg = 0; reg < REGISTER_COUNT; ++reg) {
+            Serial.print(' ');
+            Serial.print(busStats.registerWrites[reg]);
+        }
+        Serial.println();
+
+        uint32_t limit = STATS_LATENCY_FIRST_BUCKET_MICROS;
+        for (uint8_t bucket = 0; bucket < STATS_LATENCY_BUCKETS; ++bucket, limit <<= 1) {
+            if (bucket < STATS_LATENCY_BUCKETS - 1) {
+                Serial.print(F("  < "));
+                Serial.print(limit);
+            }
+            else {
+                Serial.print(F(" >= "));
+                Serial.print(limit >> 1);
+            }
+            Serial.print(F(" us: "));
+            Serial.println(busStats.latencyHistogram[bucket]);
+        }
+
+        Serial.println(F("---------------------------------------\n"));
     }
+#endif
 
     void TDA7419::printRegistersDebug() const
     {
@@ -703,16 +1304,16 @@ namespace TDA7419 {
         for (uint8_t reg = 0; reg < REGISTER_COUNT; ++reg) {
             Serial.print(F("Register "));
             Serial.print(reg);
-            if (registers[reg].isChanged()) {
+            if (isRegisterDirty(reg)) {
                 Serial.print(F("* "));
             }
             else {
                 Serial.print(F("  "));
             }
             Serial.print(F(": "));
-            printHex2(registers[reg].getValue());
+            printHex2(registers[reg]);
             Serial.print(F(" | "));
-            printBin8(registers[reg].getValue());
+            printBin8(registers[reg]);
             Serial.println();
         }
 
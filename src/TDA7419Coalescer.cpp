@@ -0,0 +1,85 @@
+#include "tda7419Coalescer.hpp"
+#include <Arduino.h>
+
+namespace TDA7419 {
+
+    FlushCoalescer::FlushCoalescer(TDA7419& device) : dev(device) {
+        for (Group& group : groups) {
+            group = Group{ 0, 0, 0 };
+        }
+    }
+
+    bool FlushCoalescer::setGroup(uint8_t index, uint32_t registerMask, uint32_t minIntervalMicros) {
+        if (index >= COALESCE_GROUP_COUNT) {
+            return false;
+        }
+
+        Group& group = groups[index];
+        group.mask = registerMask & ALL_REGISTERS_MASK;
+        group.intervalMicros = minIntervalMicros;
+        // allow the first flush right away
+        group.lastFlushMicros = micros() - minIntervalMicros;
+        return true;
+    }
+
+    bool FlushCoalescer::setGroupRate(uint8_t index, uint32_t registerMask, uint16_t maxUpdatesPerSecond) {
+        const uint32_t interval = maxUpdatesPerSecond == 0 ? 0 : (1000000UL + maxUpdatesPerSecond - 1) / maxUpdatesPerSecond;
+        return setGroup(index, registerMask, interval);
+    }
+
+    void FlushCoalescer::clearGroup(uint8_t index) {
+        if (index < COALESCE_GROUP_COUNT) {
+            groups[index] = Group{ 0, 0, 0 };
+        }
+    }
+
+    i2cResult FlushCoalescer::update() {
+        return update(micros());
+    }
+
+    i2cResult FlushCoalescer::update(uint32_t nowMicros) {
+        const uint32_t pending = dev.getDirtyMask();
+        if (pending == 0 || dev.isUpdating()) {
+            held = pending;
+            return i2cResult::OK;
+        }
+
+        // a group still inside its interval holds back all of its registers
+        uint32_t due = pending;
+        for (const Group& group : groups) {
+            if ((group.mask & pending) != 0 && nowMicros - group.lastFlushMicros < group.intervalMicros) {
+                due &= ~group.mask;
+            }
+        }
+
+        held = pending & ~due;
+        if (due == 0) {
+            return i2cResult::OK;
+        }
+
+        const i2cResult result = dev.sendChangedRegisters(due);
+
+        // the interval restarts for every group that had something sent, even if the bus failed
+        for (Group& group : groups) {
+            if ((group.mask & due) != 0) {
+                group.lastFlushMicros = nowMicros;
+            }
+        }
+
+        return result;
+    }
+
+    uint32_t FlushCoalescer::getLatencyBoundMicros(uint8_t regIndex, uint32_t updatePeriodMicros) const {
+        uint32_t interval = 0;
+        for (const Group& group : groups) {
+            if ((group.mask & (uint32_t(1) << regIndex)) != 0 && group.intervalMicros > interval) {
+                interval = group.intervalMicros;
+            }
+        }
+
+        // the costliest flush has every register pending: urgent and deferrable registers
+        // then never share a burst, so each class is split at every register of the other
+        return interval + updatePeriodMicros + dev.flushMicros(ALL_REGISTERS_MASK);
+    }
+
+} // namespace TDA7419
@@ -0,0 +1,153 @@
+#include "tda7419Fader.hpp"
+#include <Arduino.h>
+
+namespace TDA7419 {
+
+    VolumeFader::VolumeFader(TDA7419& device) : dev(device) {
+        for (Fade& fade : fades) {
+            fade = Fade{ 0, 0, FadeCurve::Linear, false, 0, 0, 0 };
+        }
+    }
+
+    void VolumeFader::fadeTo(FadeChannel channel, int8_t targetVolume, uint32_t durationMs, FadeCurve curve) {
+        if (targetVolume < MIN_SPEAKER_VOLUME) targetVolume = MIN_SPEAKER_VOLUME;
+        if (targetVolume > MAX_SPEAKER_VOLUME) targetVolume = MAX_SPEAKER_VOLUME;
+        if (durationMs > MAX_FADE_DURATION_MS) durationMs = MAX_FADE_DURATION_MS;
+
+        Fade& fade = fades[static_cast<uint8_t>(channel)];
+        const uint32_t now = micros();
+
+        // a retarget starts from wherever the running fade has got to
+        fade.from = getVolume(channel);
+        fade.to = targetVolume;
+        fade.curve = curve;
+        fade.startMicros = now;
+        fade.durationMicros = durationMs * 1000UL;
+        // allow the first step right away
+        fade.lastWriteMicros = now - getStepIntervalMicros();
+        fade.active = fade.from != fade.to;
+    }
+
+    void VolumeFader::stop(FadeChannel channel) {
+        fades[static_cast<uint8_t>(channel)].active = false;
+    }
+
+    void VolumeFader::stopAll() {
+        for (Fade& fade : fades) {
+            fade.active = false;
+        }
+    }
+
+    bool VolumeFader::isFading(FadeChannel channel) const {
+        return fades[static_cast<uint8_t>(channel)].active;
+    }
+
+    bool VolumeFader::isActive() const {
+        for (const Fade& fade : fades) {
+            if (fade.active) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    uint8_t VolumeFader::update() {
+        return update(micros());
+    }
+
+    uint8_t VolumeFader::update(uint32_t nowMicros) {
+        const uint32_t stepInterval = getStepIntervalMicros();
+        uint8_t written = 0;
+
+        for (uint8_t ch = 0; ch < FADE_CHANNEL_COUNT; ++ch) {
+            Fade& fade = fades[ch];
+            if (!fade.active) {
+                continue;
+            }
+
+            // the chip is still ramping the previous step
+            if (nowMicros - fade.lastWriteMicros < stepInterval) {
+                continue;
+            }
+
+            const uint32_t elapsed = nowMicros - fade.startMicros;
+            int8_t volume = fade.to;
+            if (elapsed < fade.durationMicros) {
+                // elapsed / duration in 1/256 units without overflowing 32 bits
+                const uint32_t durationUnits = (fade.durationMicros >> 8) + 1;
+                uint32_t progress = elapsed / durationUnits;
+                if (progress > 256) progress = 256;
+
+                const int16_t span = static_cast<int16_t>(fade.to) - fade.from;
+                const int32_t offset = static_cast<int32_t>(span) * shape(fade.curve, static_cast<uint16_t>(progress));
+                // round half away from zero
+                volume = static_cast<int8_t>(fade.from + (offset >= 0 ? (offset + 128) / 256 : (offset - 128) / 256));
+            }
+
+            const FadeChannel channel = static_cast<FadeChannel>(ch);
+            if (volume != getVolume(channel)) {
+                setVolume(channel, volume);
+                fade.lastWriteMicros = nowMicros;
+                ++written;
+            }
+
+            if (volume == fade.to) {
+                fade.active = false;
+            }
+        }
+
+        return written;
+    }
+
+    uint32_t VolumeFader::getStepIntervalMicros() const {
+        // SoftStepTime doubles from 160 us per code
+        return 160UL << static_cast<uint8_t>(dev.getSoftStepTime());
+    }
+
+    int8_t VolumeFader::getVolume(FadeChannel channel) const {
+        switch (channel) {
+        case FadeChannel::Master:
+            return dev.getMasterVolume();
+        case FadeChannel::Mixing:
+            return dev.getMixingChannelVolume();
+        case FadeChannel::Subwoofer:
+            return dev.getSubwooferVolume();
+        default:
+            return dev.getSpeakerVolume(static_cast<SpeakerChannel>(static_cast<uint8_t>(channel) - 1));
+        }
+    }
+
+    void VolumeFader::setVolume(FadeChannel channel, int8_t volume) {
+        switch (channel) {
+        case FadeChannel::Master:
+            dev.setMasterVolume(volume);
+            break;
+        case FadeChannel::Mixing:
+            dev.setMixingChannelVolume(volume);
+            break;
+        case FadeChannel::Subwoofer:
+            dev.setSubwooferVolume(volume);
+            break;
+        default:
+            dev.setSpeakerVolume(static_cast<SpeakerChannel>(static_cast<uint8_t>(channel) - 1), volume);
+            break;
+        }
+    }
+
+    uint16_t VolumeFader::shape(FadeCurve curve, uint16_t progress) {
+        const uint32_t p = progress;
+        switch (curve) {
+        case FadeCurve::EaseIn:
+            return static_cast<uint16_t>((p * p) >> 8);
+        case FadeCurve::EaseOut:
+            return static_cast<uint16_t>(256 - (((256 - p) * (256 - p)) >> 8));
+        case FadeCurve::SCurve:
+            // smoothstep: p^2 * (3 - 2p)
+            return static_cast<uint16_t>((p * p * (768 - 2 * p)) >> 16);
+        case FadeCurve::Linear:
+        default:
+            return progress;
+        }
+    }
+
+} // namespace TDA7419
@@ -0,0 +1,141 @@
+#include "tda7419GainPlanner.hpp"
+#include <Arduino.h>
+
+namespace TDA7419 {
+
+    namespace {
+        // current[] layout: input gain, master, then the channel volumes
+        constexpr uint8_t CURRENT_GAIN = 0;
+        constexpr uint8_t CURRENT_MASTER = 1;
+        constexpr uint8_t CURRENT_CHANNELS = 2;
+
+        // MIN_SPEAKER_VOLUME is the mute code, not a -80 dB step: the planner never picks it
+        constexpr int8_t MIN_PLANNED_VOLUME = MIN_SPEAKER_VOLUME + 1;
+
+        // 10^(dB/10) in 1/4096 units for dB in [NOISE_MIN_DB..NOISE_MAX_DB]
+        constexpr int8_t NOISE_MIN_DB = -36;
+        constexpr int8_t NOISE_MAX_DB = 20;
+        constexpr uint32_t NOISE_WEIGHTS[NOISE_MAX_DB - NOISE_MIN_DB + 1] PROGMEM = {
+            1, 1, 2, 2, 3, 3, 4, 5, 6, 8, 10, 13, 16, 21, 26, 33,                          // -36..-21 dB
+            41, 52, 65, 82, 103, 130, 163, 205, 258, 325, 410, 516, 649, 817, 1029, 1295,  // -20..-5 dB
+            1631, 2053, 2584, 3254, 4096,                                                   // -4..0 dB
+            5157, 6492, 8173, 10289, 12953, 16306, 20529, 25844, 32536, 40960,              // +1..+10 dB
+            51566, 64917, 81726, 102887, 129527, 163065, 205286, 258440, 325357, 409600     // +11..+20 dB
+        };
+
+        // 10^(dB/10) in 1/256 units for the equivalence tolerance
+        constexpr uint16_t TOLERANCE_FACTORS[GAIN_MAX_TOLERANCE_DB + 1] = { 256, 322, 406, 511, 643, 810, 1019 };
+    }
+
+    uint32_t gainNoiseWeight(int16_t gainAfterDb) {
+        if (gainAfterDb < NOISE_MIN_DB) {
+            return 0;
+        }
+        if (gainAfterDb > NOISE_MAX_DB) {
+            gainAfterDb = NOISE_MAX_DB;
+        }
+        return pgm_read_dword(&NOISE_WEIGHTS[gainAfterDb - NOISE_MIN_DB]);
+    }
+
+    GainPlanner::GainPlanner(TDA7419& device) : dev(device) {
+        trims.fill(0);
+    }
+
+    void GainPlanner::evaluate(uint8_t gain, int8_t master, uint8_t loudness, const int16_t* targets, const int8_t* current, GainPlan& out) {
+        out.inputGain = gain;
+        out.masterVolume = master;
+        out.errorDb = 0;
+        out.noiseWeight = 0;
+        out.changedRegisters = (gain != static_cast<uint8_t>(current[CURRENT_GAIN])) + (master != current[CURRENT_MASTER]);
+
+        // level in front of the channel attenuators
+        const int16_t common = static_cast<int16_t>(gain) - loudness + master;
+
+        for (uint8_t ch = 0; ch < GAIN_CHANNEL_COUNT; ++ch) {
+            int16_t volume = targets[ch] - common;
+            if (volume < MIN_PLANNED_VOLUME) volume = MIN_PLANNED_VOLUME;
+            if (volume > MAX_SPEAKER_VOLUME) volume = MAX_SPEAKER_VOLUME;
+            out.channel[ch] = static_cast<int8_t>(volume);
+
+            const int16_t reached = common + volume;
+            out.errorDb += static_cast<uint16_t>(reached > targets[ch] ? reached - targets[ch] : targets[ch] - reached);
+            out.changedRegisters += volume != current[CURRENT_CHANNELS + ch];
+
+            // noise of the input, loudness and master stages as heard at the output
+            out.noiseWeight += gainNoiseWeight(volume + master - loudness) + gainNoiseWeight(volume + master) + gainNoiseWeight(volume);
+        }
+    }
+
+    GainPlan GainPlanner::plan(int8_t targetDb) const {
+        const uint8_t loudness = dev.getLoudnessAttenuation();
+
+        int8_t current[CURRENT_CHANNELS + GAIN_CHANNEL_COUNT];
+        current[CURRENT_GAIN] = static_cast<int8_t>(dev.getInputGain());
+        current[CURRENT_MASTER] = dev.getMasterVolume();
+        for (uint8_t ch = 0; ch < SPEAKER_CHANNEL_COUNT; ++ch) {
+            current[CURRENT_CHANNELS + ch] = dev.getSpeakerVolume(static_cast<SpeakerChannel>(ch));
+        }
+        current[CURRENT_CHANNELS + static_cast<uint8_t>(GainChannel::Subwoofer)] = dev.getSubwooferVolume();
+
+        int16_t targets[GAIN_CHANNEL_COUNT];
+        for (uint8_t ch = 0; ch < GAIN_CHANNEL_COUNT; ++ch) {
+            targets[ch] = static_cast<int16_t>(targetDb) + trims[ch];
+        }
+
+        // the input stage and the master output may not exceed the headroom
+        const uint8_t maxGain = headroom;
+
+        // pass 1: smallest error, then the quietest combination with that error
+        GainPlan best{};
+        best.errorDb = 0xFFFF;
+        GainPlan candidate;
+        for (uint8_t gain = 0; gain <= maxGain; ++gain) {
+            for (int16_t master = MIN_PLANNED_VOLUME; master <= MAX_SPEAKER_VOLUME; ++master) {
+                if (static_cast<int16_t>(gain) - loudness + master > headroom) {
+                    break;
+                }
+                evaluate(gain, static_cast<int8_t>(master), loudness, targets, current, candidate);
+                if (candidate.errorDb < best.errorDb ||
+                    (candidate.errorDb == best.errorDb && candidate.noiseWeight < best.noiseWeight)) {
+                    best = candidate;
+                }
+            }
+        }
+
+        // pass 2: among combinations as exact and within the noise tolerance, change the fewest registers
+        const uint16_t factor = TOLERANCE_FACTORS[tolerance];
+        const uint32_t noiseLimit = (best.noiseWeight >> 8) * factor + (((best.noiseWeight & 0xFF) * factor) >> 8);
+        GainPlan chosen = best;
+        for (uint8_t gain = 0; gain <= maxGain; ++gain) {
+            for (int16_t master = MIN_PLANNED_VOLUME; master <= MAX_SPEAKER_VOLUME; ++master) {
+                if (static_cast<int16_t>(gain) - loudness + master > headroom) {
+                    break;
+                }
+                evaluate(gain, static_cast<int8_t>(master), loudness, targets, current, candidate);
+                if (candidate.errorDb != best.errorDb || candidate.noiseWeight > noiseLimit) {
+                    continue;
+                }
+                if (candidate.changedRegisters < chosen.changedRegisters ||
+                    (candidate.changedRegisters == chosen.changedRegisters && candidate.noiseWeight < chosen.noiseWeight)) {
+                    chosen = candidate;
+                }
+            }
+        }
+
+        return chosen;
+    }
+
+    GainPlan GainPlanner::apply(int8_t targetDb) {
+        const GainPlan result = plan(targetDb);
+
+        dev.setInputGain(result.inputGain);
+        dev.setMasterVolume(result.masterVolume);
+        for (uint8_t ch = 0; ch < SPEAKER_CHANNEL_COUNT; ++ch) {
+            dev.setSpeakerVolume(static_cast<SpeakerChannel>(ch), result.channel[ch]);
+        }
+        dev.setSubwooferVolume(result.channel[static_cast<uint8_t>(GainChannel::Subwoofer)]);
+
+        return result;
+    }
+
+} // namespace TDA7419
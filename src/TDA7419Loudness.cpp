@@ -0,0 +1,71 @@
+#include "tda7419Loudness.hpp"
+
+namespace TDA7419 {
+
+    constexpr LoudnessStep DEFAULT_LOUDNESS_CONTOUR[DEFAULT_LOUDNESS_STEP_COUNT] = {
+        {   0,  0, LoudnessCenterFreq::Flat,  false },
+        { -10,  3, LoudnessCenterFreq::Hz400, false },
+        { -20,  6, LoudnessCenterFreq::Hz400, false },
+        { -30,  9, LoudnessCenterFreq::Hz400, true },
+        { -45, 12, LoudnessCenterFreq::Hz400, true },
+        { -80, 15, LoudnessCenterFreq::Hz400, true }
+    };
+
+    LoudnessTracker::LoudnessTracker(TDA7419& device) : dev(device) {
+    }
+
+    bool LoudnessTracker::setContour(const LoudnessStep* steps, uint8_t count) {
+        if (steps == nullptr || count == 0) {
+            return false;
+        }
+
+        contour = steps;
+        stepCount = count;
+        stepIndex = NO_STEP;
+        return true;
+    }
+
+    bool LoudnessTracker::update() {
+        return update(dev.getMasterVolume());
+    }
+
+    bool LoudnessTracker::update(int8_t volume) {
+        const uint8_t natural = stepFor(volume);
+        if (natural == stepIndex) {
+            return false;
+        }
+
+        uint8_t target = natural;
+        if (stepIndex != NO_STEP) {
+            // leave the current step only once the volume is past the boundary by the hysteresis
+            const bool louder = natural < stepIndex;
+            target = louder ? stepFor(volume - hysteresis) : stepFor(volume + hysteresis);
+            if (louder ? target >= stepIndex : target <= stepIndex) {
+                return false;
+            }
+        }
+
+        stepIndex = target;
+        const uint8_t before = dev.getRegisterValue(REG_LOUDNESS_CONTROL);
+        apply(target);
+        return dev.getRegisterValue(REG_LOUDNESS_CONTROL) != before;
+    }
+
+    uint8_t LoudnessTracker::stepFor(int16_t volume) const {
+        for (uint8_t i = 0; i + 1 < stepCount; ++i) {
+            if (volume >= contour[i].fromVolume) {
+                return i;
+            }
+        }
+        return stepCount - 1;
+    }
+
+    void LoudnessTracker::apply(uint8_t index) {
+        const LoudnessStep& step = contour[index];
+        dev.setLoudnessAttenuation(step.attenuation);
+        dev.setLoudnessCenterFreq(step.centerFreq);
+        // register 1 bit 6 is active low: 0 turns the high boost on
+        dev.setLoudnessHighBoost(!step.highBoost);
+    }
+
+} // namespace TDA7419
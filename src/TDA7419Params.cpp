@@ -0,0 +1,452 @@
+#include "tda7419Params.hpp"
+#include <Arduino.h>
+
+namespace TDA7419 {
+
+    namespace {
+        // keys in ParamId order, separated by NUL
+        const char PARAM_KEYS[] PROGMEM =
+            "mainSource\0"
+            "inputGain\0"
+            "rearSpeakerSource\0"
+            "secondSource\0"
+            "secondSourceInputGain\0"
+            "autoZero\0"
+            "loudnessAttenuation\0"
+            "loudnessCenterFreq\0"
+            "loudnessHighBoost\0"
+            "loudnessSoftStep\0"
+            "softMute\0"
+            "mutePinEnable\0"
+            "softMuteTime\0"
+            "softStepTime\0"
+            "clockFastMode\0"
+            "masterVolumeSoftStep\0"
+            "masterVolume\0"
+            "trebleLevel\0"
+            "trebleCenterFreq\0"
+            "trebleReferenceInternal\0"
+            "middleSoftStep\0"
+            "middleLevel\0"
+            "middleQFactor\0"
+            "bassSoftStep\0"
+            "bassLevel\0"
+            "bassQFactor\0"
+            "smoothingFilter\0"
+            "bassDcMode\0"
+            "bassCenterFreq\0"
+            "middleCenterFreq\0"
+            "subCutoffFreq\0"
+            "mixingGainEffect\0"
+            "subwooferEnable\0"
+            "mixingEnable\0"
+            "mixToRightFront\0"
+            "mixToLeftFront\0"
+            "speakerLFSoftStep\0"
+            "speakerRFSoftStep\0"
+            "speakerLRSoftStep\0"
+            "speakerRRSoftStep\0"
+            "speakerLFVolume\0"
+            "speakerRFVolume\0"
+            "speakerLRVolume\0"
+            "speakerRRVolume\0"
+            "mixingChannelSoftStep\0"
+            "mixingChannelVolume\0"
+            "subwooferSoftStep\0"
+            "subwooferVolume\0"
+            "spectrumCouplingMode\0"
+            "externalClock\0"
+            "spectrumReset\0"
+            "spectrumRun\0"
+            "spectrumSource\0"
+            "spectrumAutoReset\0"
+            "spectrumFilterQ\0";
+
+        const ParamInfo PARAM_INFO[PARAM_COUNT] PROGMEM = {
+            { 0, 4, ParamKind::Enum },       // mainSource
+            { 0, 15, ParamKind::Number },    // inputGain
+            { 0, 1, ParamKind::Enum },       // rearSpeakerSource
+            { 0, 4, ParamKind::Enum },       // secondSource
+            { 0, 15, ParamKind::Number },    // secondSourceInputGain
+            { 0, 1, ParamKind::Bool },       // autoZero
+            { 0, 15, ParamKind::Number },    // loudnessAttenuation
+            { 0, 3, ParamKind::Enum },       // loudnessCenterFreq
+            { 0, 1, ParamKind::Bool },       // loudnessHighBoost
+            { 0, 1, ParamKind::Bool },       // loudnessSoftStep
+            { 0, 1, ParamKind::Bool },       // softMute
+            { 0, 1, ParamKind::Bool },       // mutePinEnable
+            { 0, 2, ParamKind::Enum },       // softMuteTime
+            { 0, 7, ParamKind::Enum },       // softStepTime
+            { 0, 1, ParamKind::Bool },       // clockFastMode
+            { 0, 1, ParamKind::Bool },       // masterVolumeSoftStep
+            { -80, 15, ParamKind::Number },  // masterVolume
+            { -15, 15, ParamKind::Number },  // trebleLevel
+            { 0, 3, ParamKind::Enum },       // trebleCenterFreq
+            { 0, 1, ParamKind::Bool },       // trebleReferenceInternal
+            { 0, 1, ParamKind::Bool },       // middleSoftStep
+            { -15, 15, ParamKind::Number },  // middleLevel
+            { 0, 3, ParamKind::Enum },       // middleQFactor
+            { 0, 1, ParamKind::Bool },       // bassSoftStep
+            { -15, 15, ParamKind::Number },  // bassLevel
+            { 0, 3, ParamKind::Enum },       // bassQFactor
+            { 0, 1, ParamKind::Bool },       // smoothingFilter
+            { 0, 1, ParamKind::Bool },       // bassDcMode
+            { 0, 3, ParamKind::Enum },       // bassCenterFreq
+            { 0, 3, ParamKind::Enum },       // middleCenterFreq
+            { 0, 3, ParamKind::Enum },       // subCutoffFreq
+            { 0, 9, ParamKind::Enum },       // mixingGainEffect
+            { 0, 1, ParamKind::Bool },       // subwooferEnable
+            { 0, 1, ParamKind::Bool },       // mixingEnable
+            { 0, 1, ParamKind::Bool },       // mixToRightFront
+            { 0, 1, ParamKind::Bool },       // mixToLeftFront
+            { 0, 1, ParamKind::Bool },       // speakerLFSoftStep
+            { 0, 1, ParamKind::Bool },       // speakerRFSoftStep
+            { 0, 1, ParamKind::Bool },       // speakerLRSoftStep
+            { 0, 1, ParamKind::Bool },       // speakerRRSoftStep
+            { -80, 15, ParamKind::Number },  // speakerLFVolume
+            { -80, 15, ParamKind::Number },  // speakerRFVolume
+            { -80, 15, ParamKind::Number },  // speakerLRVolume
+            { -80, 15, ParamKind::Number },  // speakerRRVolume
+            { 0, 1, ParamKind::Bool },       // mixingChannelSoftStep
+            { -80, 15, ParamKind::Number },  // mixingChannelVolume
+            { 0, 1, ParamKind::Bool },       // subwooferSoftStep
+            { -80, 15, ParamKind::Number },  // subwooferVolume
+            { 0, 3, ParamKind::Enum },       // spectrumCouplingMode
+            { 0, 1, ParamKind::Bool },       // externalClock
+            { 0, 1, ParamKind::Bool },       // spectrumReset
+            { 0, 1, ParamKind::Bool },       // spectrumRun
+            { 0, 1, ParamKind::Enum },       // spectrumSource
+            { 0, 1, ParamKind::Bool },       // spectrumAutoReset
+            { 0, 1, ParamKind::Enum },       // spectrumFilterQ
+        };
+
+        ParamInfo readInfo(uint8_t id) {
+            ParamInfo info;
+            info.min = static_cast<int8_t>(pgm_read_byte(&PARAM_INFO[id].min));
+            info.max = static_cast<int8_t>(pgm_read_byte(&PARAM_INFO[id].max));
+            info.kind = static_cast<ParamKind>(pgm_read_byte(&PARAM_INFO[id].kind));
+            return info;
+        }
+    }
+
+    ParamInfo getParamInfo(uint8_t id) {
+        if (id >= PARAM_COUNT) {
+            return ParamInfo{ 0, 0, ParamKind::Number };
+        }
+        return readInfo(id);
+    }
+
+    const char* getParamKey(uint8_t id) {
+        if (id >= PARAM_COUNT) {
+            return nullptr;
+        }
+
+        const char* key = PARAM_KEYS;
+        for (; id > 0; --id) {
+            while (pgm_read_byte(key++) != 0) {
+            }
+        }
+        return key;
+    }
+
+    uint8_t findParam(const char* key, uint8_t length) {
+        const char* entry = PARAM_KEYS;
+        for (uint8_t id = 0; id < PARAM_COUNT; ++id) {
+            // compare, then skip the rest of the entry including its NUL
+            uint8_t i = 0;
+            char c = static_cast<char>(pgm_read_byte(entry));
+            while (i < length && c != 0 && c == key[i]) {
+                ++i;
+                c = static_cast<char>(pgm_read_byte(entry + i));
+            }
+            if (i == length && c == 0) {
+                return id;
+            }
+            entry += i;
+            while (pgm_read_byte(entry++) != 0) {
+            }
+        }
+        return PARAM_NONE;
+    }
+
+    int16_t getParam(const TDA7419& dev, uint8_t id) {
+        switch (static_cast<ParamId>(id)) {
+        case ParamId::MainSource:
+            return static_cast<uint8_t>(dev.getMainSource());
+        case ParamId::InputGain:
+            return dev.getInputGain();
+        case ParamId::RearSpeakerSource:
+            return static_cast<uint8_t>(dev.getRearSpeakerSource());
+        case ParamId::SecondSource:
+            return static_cast<uint8_t>(dev.getSecondSource());
+        case ParamId::SecondSourceInputGain:
+            return dev.getSecondSourceInputGain();
+        case ParamId::AutoZero:
+            return dev.getAutoZero();
+        case ParamId::LoudnessAttenuation:
+            return dev.getLoudnessAttenuation();
+        case ParamId::LoudnessCenterFreq:
+            return static_cast<uint8_t>(dev.getLoudnessCenterFreq());
+        case ParamId::LoudnessHighBoost:
+            return dev.getLoudnessHighBoost();
+        case ParamId::LoudnessSoftStep:
+            return dev.getLoudnessSoftStep();
+        case ParamId::SoftMute:
+            return dev.getSoftMute();
+        case ParamId::MutePinEnable:
+            return dev.getMutePinEnable();
+        case ParamId::SoftMuteTime:
+            return static_cast<uint8_t>(dev.getSoftMuteTime());
+        case ParamId::SoftStepTime:
+            return static_cast<uint8_t>(dev.getSoftStepTime());
+        case ParamId::ClockFastMode:
+            return dev.getClockFastMode();
+        case ParamId::MasterVolumeSoftStep:
+            return dev.getMasterVolumeSoftStep();
+        case ParamId::MasterVolume:
+            return dev.getMasterVolume();
+        case ParamId::TrebleLevel:
+            return dev.getTrebleLevel();
+        case ParamId::TrebleCenterFreq:
+            return static_cast<uint8_t>(dev.getTrebleCenterFreq());
+        case ParamId::TrebleReferenceInternal:
+            return dev.getTrebleReferenceInternal();
+        case ParamId::MiddleSoftStep:
+            return dev.getMiddleSoftStepEnabled();
+        case ParamId::MiddleLevel:
+            return dev.getMiddleLevel();
+        case ParamId::MiddleQFactor:
+            return static_cast<uint8_t>(dev.getMiddleQFactor());
+        case ParamId::BassSoftStep:
+            return dev.getBassSoftStep();
+        case ParamId::BassLevel:
+            return dev.getBassLevel();
+        case ParamId::BassQFactor:
+            return static_cast<uint8_t>(dev.getBassQFactor());
+        case ParamId::SmoothingFilter:
+            return dev.getSmoothingFilter();
+        case ParamId::BassDcMode:
+            return dev.getBassDcMode();
+        case ParamId::BassCenterFreq:
+            return static_cast<uint8_t>(dev.getBassCenterFreq());
+        case ParamId::MiddleCenterFreq:
+            return static_cast<uint8_t>(dev.getMiddleCenterFreq());
+        case ParamId::SubCutoffFreq:
+            return static_cast<uint8_t>(dev.getSubCutoffFreq());
+        case ParamId::MixingGainEffect:
+            return static_cast<uint8_t>(dev.getMixingGainEffect());
+        case ParamId::SubwooferEnable:
+            return dev.getSubwooferEnable();
+        case ParamId::MixingEnable:
+            return dev.getMixingEnable();
+        case ParamId::MixToRightFront:
+            return dev.getMixToRightFront();
+        case ParamId::MixToLeftFront:
+            return dev.getMixToLeftFront();
+        case ParamId::SpeakerLFSoftStep:
+        case ParamId::SpeakerRFSoftStep:
+        case ParamId::SpeakerLRSoftStep:
+        case ParamId::SpeakerRRSoftStep:
+            return dev.getSpeakerSoftStep(static_cast<SpeakerChannel>(id - static_cast<uint8_t>(ParamId::SpeakerLFSoftStep)));
+        case ParamId::SpeakerLFVolume:
+        case ParamId::SpeakerRFVolume:
+        case ParamId::SpeakerLRVolume:
+        case ParamId::SpeakerRRVolume:
+            return dev.getSpeakerVolume(static_cast<SpeakerChannel>(id - static_cast<uint8_t>(ParamId::SpeakerLFVolume)));
+        case ParamId::MixingChannelSoftStep:
+            return dev.getMixingChannelSoftStep();
+        case ParamId::MixingChannelVolume:
+            return dev.getMixingChannelVolume();
+        case ParamId::SubwooferSoftStep:
+            return dev.getSubwooferSoftStep();
+        case ParamId::SubwooferVolume:
+            return dev.getSubwooferVolume();
+        case ParamId::SpectrumCouplingMode:
+            return static_cast<uint8_t>(dev.getSpectrumCouplingMode());
+        case ParamId::ExternalClock:
+            return dev.getExternalClock();
+        case ParamId::SpectrumReset:
+            return dev.getSpectrumReset();
+        case ParamId::SpectrumRun:
+            return dev.getSpectrumRun();
+        case ParamId::SpectrumSource:
+            return static_cast<uint8_t>(dev.getSpectrumSource());
+        case ParamId::SpectrumAutoReset:
+            return dev.getSpectrumAutoReset();
+        case ParamId::SpectrumFilterQ:
+            return static_cast<uint8_t>(dev.getSpectrumFilterQ());
+        default:
+            return 0;
+        }
+    }
+
+    bool setParam(TDA7419& dev, uint8_t id, int16_t value) {
+        if (id >= PARAM_COUNT) {
+            return false;
+        }
+        const ParamInfo info = readInfo(id);
+        if (value < info.min || value > info.max) {
+            return false;
+        }
+
+        switch (static_cast<ParamId>(id)) {
+        case ParamId::MainSource:
+            dev.setMainSource(static_cast<InputSource>(value));
+            break;
+        case ParamId::InputGain:
+            dev.setInputGain(static_cast<uint8_t>(value));
+            break;
+        case ParamId::RearSpeakerSource:
+            dev.setRearSpeakerSource(static_cast<RearSpeakerSource>(value));
+            break;
+        case ParamId::SecondSource:
+            dev.setSecondSource(static_cast<InputSource>(value));
+            break;
+        case ParamId::SecondSourceInputGain:
+            dev.setSecondSourceInputGain(static_cast<uint8_t>(value));
+            break;
+        case ParamId::AutoZero:
+            dev.setAutoZero(value != 0);
+            break;
+        case ParamId::LoudnessAttenuation:
+            dev.setLoudnessAttenuation(static_cast<uint8_t>(value));
+            break;
+        case ParamId::LoudnessCenterFreq:
+            dev.setLoudnessCenterFreq(static_cast<LoudnessCenterFreq>(value));
+            break;
+        case ParamId::LoudnessHighBoost:
+            dev.setLoudnessHighBoost(value != 0);
+            break;
+        case ParamId::LoudnessSoftStep:
+            dev.setLoudnessSoftStep(value != 0);
+            break;
+        case ParamId::SoftMute:
+            dev.setSoftMute(value != 0);
+            break;
+        case ParamId::MutePinEnable:
+            dev.setMutePinEnable(value != 0);
+            break;
+        case ParamId::SoftMuteTime:
+            dev.setSoftMuteTime(static_cast<SoftMuteTime>(value));
+            break;
+        case ParamId::SoftStepTime:
+            dev.setSoftStepTime(static_cast<SoftStepTime>(value));
+            break;
+        case ParamId::ClockFastMode:
+            dev.setClockFastMode(value != 0);
+            break;
+        case ParamId::MasterVolumeSoftStep:
+            dev.setMasterVolumeSoftStep(value != 0);
+            break;
+        case ParamId::MasterVolume:
+            dev.setMasterVolume(static_cast<int8_t>(value));
+            break;
+        case ParamId::TrebleLevel:
+            dev.setTrebleLevel(static_cast<int8_t>(value));
+            break;
+        case ParamId::TrebleCenterFreq:
+            dev.setTrebleCenterFreq(static_cast<TrebleCenterFreq>(value));
+            break;
+        case ParamId::TrebleReferenceInternal:
+            dev.setTrebleReferenceInternal(value != 0);
+            break;
+        case ParamId::MiddleSoftStep:
+            dev.setMiddleSoftStep(value != 0);
+            break;
+        case ParamId::MiddleLevel:
+            dev.setMiddleLevel(static_cast<int8_t>(value));
+            break;
+        case ParamId::MiddleQFactor:
+            dev.setMiddleQFactor(static_cast<MiddleQFactor>(value));
+            break;
+        case ParamId::BassSoftStep:
+            dev.setBassSoftStep(value != 0);
+            break;
+        case ParamId::BassLevel:
+            dev.setBassLevel(static_cast<int8_t>(value));
+            break;
+        case ParamId::BassQFactor:
+            dev.setBassQFactor(static_cast<BassQFactor>(value));
+            break;
+        case ParamId::SmoothingFilter:
+            dev.setSmoothingFilter(value != 0);
+            break;
+        case ParamId::BassDcMode:
+            dev.setBassDcMode(value != 0);
+            break;
+        case ParamId::BassCenterFreq:
+            dev.setBassCenterFreq(static_cast<BassCenterFreq>(value));
+            break;
+        case ParamId::MiddleCenterFreq:
+            dev.setMiddleCenterFreq(static_cast<MiddleCenterFreq>(value));
+            break;
+        case ParamId::SubCutoffFreq:
+            dev.setSubCutoffFreq(static_cast<SubCutoffFreq>(value));
+            break;
+        case ParamId::MixingGainEffect:
+            dev.setMixingGainEffect(static_cast<MixingGainEffect>(value));
+            break;
+        case ParamId::SubwooferEnable:
+            dev.setSubwooferEnable(value != 0);
+            break;
+        case ParamId::MixingEnable:
+            dev.setMixingEnable(value != 0);
+            break;
+        case ParamId::MixToRightFront:
+            dev.setMixToRightFront(value != 0);
+            break;
+        case ParamId::MixToLeftFront:
+            dev.setMixToLeftFront(value != 0);
+            break;
+        case ParamId::SpeakerLFSoftStep:
+        case ParamId::SpeakerRFSoftStep:
+        case ParamId::SpeakerLRSoftStep:
+        case ParamId::SpeakerRRSoftStep:
+            dev.setSpeakerSoftStep(static_cast<SpeakerChannel>(id - static_cast<uint8_t>(ParamId::SpeakerLFSoftStep)), value != 0);
+            break;
+        case ParamId::SpeakerLFVolume:
+        case ParamId::SpeakerRFVolume:
+        case ParamId::SpeakerLRVolume:
+        case ParamId::SpeakerRRVolume:
+            dev.setSpeakerVolume(static_cast<SpeakerChannel>(id - static_cast<uint8_t>(ParamId::SpeakerLFVolume)), static_cast<int8_t>(value));
+            break;
+        case ParamId::MixingChannelSoftStep:
+            dev.setMixingChannelSoftStep(value != 0);
+            break;
+        case ParamId::MixingChannelVolume:
+            dev.setMixingChannelVolume(static_cast<int8_t>(value));
+            break;
+        case ParamId::SubwooferSoftStep:
+            dev.setSubwooferSoftStep(value != 0);
+            break;
+        case ParamId::SubwooferVolume:
+            dev.setSubwooferVolume(static_cast<int8_t>(value));
+            break;
+        case ParamId::SpectrumCouplingMode:
+            dev.setSpectrumCouplingMode(static_cast<SpectrumCouplingMode>(value));
+            break;
+        case ParamId::ExternalClock:
+            dev.setExternalClock(value != 0);
+            break;
+        case ParamId::SpectrumReset:
+            dev.setSpectrumReset(value != 0);
+            break;
+        case ParamId::SpectrumRun:
+            dev.setSpectrumRun(value != 0);
+            break;
+        case ParamId::SpectrumSource:
+            dev.setSpectrumSource(static_cast<SpectrumSource>(value));
+            break;
+        case ParamId::SpectrumAutoReset:
+            dev.setSpectrumAutoReset(value != 0);
+            break;
+        case ParamId::SpectrumFilterQ:
+            dev.setSpectrumFilterQ(static_cast<SpectrumFilterQ>(value));
+            break;
+        default:
+            return false;
+        }
+        return true;
+    }
+
+} // namespace TDA7419
@@ -0,0 +1,193 @@
+#include "tda7419Protocol.hpp"
+
+namespace TDA7419 {
+
+    uint16_t frameCrc(uint16_t crc, uint8_t byte) {
+        crc ^= static_cast<uint16_t>(byte) << 8;
+        for (uint8_t bit = 0; bit < 8; ++bit) {
+            crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x1021) : static_cast<uint16_t>(crc << 1);
+        }
+        return crc;
+    }
+
+    uint8_t encodeFrame(uint8_t command, const uint8_t* payload, uint8_t length, uint8_t* out) {
+        if (length >= FRAME_MAX_LENGTH) {
+            return 0;
+        }
+
+        out[0] = FRAME_SOF;
+        out[1] = length + 1;
+        out[2] = command;
+        uint16_t crc = frameCrc(frameCrc(0xFFFF, out[1]), command);
+        for (uint8_t i = 0; i < length; ++i) {
+            out[3 + i] = payload[i];
+            crc = frameCrc(crc, payload[i]);
+        }
+        out[3 + length] = static_cast<uint8_t>(crc);
+        out[4 + length] = static_cast<uint8_t>(crc >> 8);
+        return FRAME_OVERHEAD + 1 + length;
+    }
+
+    FrameProtocol::FrameProtocol(TDA7419& device, FrameWriteFn write, void* context)
+        : dev(device), writeFn(write), writeContext(context) {
+    }
+
+    void FrameProtocol::feed(const uint8_t* data, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            feed(data[i]);
+        }
+    }
+
+    void FrameProtocol::feed(uint8_t byte) {
+        switch (rx) {
+        case Rx::Sof:
+            if (byte == FRAME_SOF) {
+                rx = Rx::Length;
+            }
+            break;
+
+        case Rx::Length:
+            if (byte == 0 || byte > FRAME_MAX_LENGTH) {
+                ++errors;
+                rx = Rx::Sof;
+                break;
+            }
+            length = byte;
+            received = 0;
+            crc = frameCrc(0xFFFF, byte);
+            rx = Rx::Body;
+            break;
+
+        case Rx::Body:
+            body[received++] = byte;
+            crc = frameCrc(crc, byte);
+            if (received == length) {
+                rx = Rx::CrcLow;
+            }
+            break;
+
+        case Rx::CrcLow:
+            crcLow = byte;
+            rx = Rx::CrcHigh;
+            break;
+
+        case Rx::CrcHigh:
+            rx = Rx::Sof;
+            if (crc != (static_cast<uint16_t>(byte) << 8 | crcLow)) {
+                ++errors;
+                break;
+            }
+            ++frames;
+            execute();
+            break;
+        }
+    }
+
+    void FrameProtocol::execute() {
+        const uint8_t command = body[0];
+        const uint8_t* payload = body + 1;
+        const uint8_t payloadLength = length - 1;
+
+        switch (static_cast<FrameCommand>(command)) {
+        case FrameCommand::Ping:
+            beginResponse(command | FRAME_RESPONSE_BIT, 0);
+            endResponse();
+            break;
+
+        case FrameCommand::Set:
+        case FrameCommand::SetRun: {
+            // every value of the frame lands in the shadow before the one flush in commit()
+            uint8_t applied = 0;
+            uint8_t rejected = 0;
+            dev.beginUpdate();
+            if (command == static_cast<uint8_t>(FrameCommand::Set)) {
+                for (uint8_t i = 0; i + 1 < payloadLength; i += 2) {
+                    if (setParam(dev, payload[i], static_cast<int8_t>(payload[i + 1]))) {
+                        ++applied;
+                    }
+                    else {
+                        ++rejected;
+                    }
+                }
+                rejected += payloadLength & 1;
+            }
+            else {
+                for (uint8_t i = 1; i < payloadLength; ++i) {
+                    const uint16_t id = payload[0] + i - 1;
+                    if (id < PARAM_COUNT && setParam(dev, static_cast<uint8_t>(id), static_cast<int8_t>(payload[i]))) {
+                        ++applied;
+                    }
+                    else {
+                        ++rejected;
+                    }
+                }
+            }
+            respondSet(command, applied, rejected, dev.commit());
+            break;
+        }
+
+        case FrameCommand::Get: {
+            // the answer has to fit in one frame as well
+            uint8_t known = 0;
+            for (uint8_t i = 0; i < payloadLength && known < FRAME_GET_MAX_PAIRS; ++i) {
+                known += payload[i] < PARAM_COUNT;
+            }
+            beginResponse(command | FRAME_RESPONSE_BIT, 2 * known);
+            for (uint8_t i = 0, sent = 0; i < payloadLength && sent < known; ++i) {
+                if (payload[i] < PARAM_COUNT) {
+                    const uint8_t pair[2] = { payload[i], static_cast<uint8_t>(getParam(dev, payload[i])) };
+                    emit(pair, 2);
+                    ++sent;
+                }
+            }
+            endResponse();
+            break;
+        }
+
+        case FrameCommand::GetAll: {
+            beginResponse(command | FRAME_RESPONSE_BIT, 1 + PARAM_COUNT);
+            const uint8_t first = 0;
+            emit(&first, 1);
+            for (uint8_t id = 0; id < PARAM_COUNT; ++id) {
+                const uint8_t value = static_cast<uint8_t>(getParam(dev, id));
+                emit(&value, 1);
+            }
+            endResponse();
+            break;
+        }
+
+        default:
+            beginResponse(FRAME_NAK, 1);
+            emit(&command, 1);
+            endResponse();
+            break;
+        }
+    }
+
+    void FrameProtocol::respondSet(uint8_t command, uint8_t applied, uint8_t rejected, i2cResult result) {
+        beginResponse(command | FRAME_RESPONSE_BIT, 3);
+        const uint8_t status[3] = { applied, rejected, static_cast<uint8_t>(result) };
+        emit(status, 3);
+        endResponse();
+    }
+
+    void FrameProtocol::beginResponse(uint8_t response, uint8_t payloadLength) {
+        const uint8_t header[3] = { FRAME_SOF, static_cast<uint8_t>(payloadLength + 1), response };
+        writeFn(writeContext, header, 1);
+        txCrc = 0xFFFF;
+        emit(header + 1, 2);
+    }
+
+    void FrameProtocol::emit(const uint8_t* data, uint8_t count) {
+        for (uint8_t i = 0; i < count; ++i) {
+            txCrc = frameCrc(txCrc, data[i]);
+        }
+        writeFn(writeContext, data, count);
+    }
+
+    void FrameProtocol::endResponse() {
+        const uint8_t trailer[2] = { static_cast<uint8_t>(txCrc), static_cast<uint8_t>(txCrc >> 8) };
+        writeFn(writeContext, trailer, 2);
+    }
+
+} // namespace TDA7419
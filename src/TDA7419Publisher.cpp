@@ -0,0 +1,61 @@
+#include "tda7419Publisher.hpp"
+
+namespace TDA7419 {
+
+    ImagePublisher::ImagePublisher(TDA7419& device) : dev(device) {
+        for (RegisterImage& slot : slots) {
+            dev.getRegisterImage(slot);
+        }
+    }
+
+    void ImagePublisher::publish() {
+        dev.getRegisterImage(slots[writeSlot]);
+
+        // hand the new image over and continue with whatever slot comes back
+        writeSlot = shadow::exchange(handover, static_cast<uint8_t>(writeSlot | FRESH)) & ~FRESH;
+    }
+
+    uint32_t ImagePublisher::getPendingMask() const {
+        const RegisterImage& front = slots[readSlot];
+        uint32_t pending = ALL_REGISTERS_MASK & ~ackedMask;
+        for (uint8_t reg = 0; reg < REGISTER_COUNT; ++reg) {
+            if (front[reg] != acked[reg]) {
+                pending |= registerRangeMask(reg, 1);
+            }
+        }
+        return pending;
+    }
+
+    i2cResult ImagePublisher::update() {
+        if (shadow::load(handover) & FRESH) {
+            readSlot = shadow::exchange(handover, readSlot) & ~FRESH;
+        }
+
+        const uint32_t pending = getPendingMask();
+        if (pending == 0) {
+            dev.acknowledgeImage(acked, ackedMask & dev.getDirtyMask());
+            return i2cResult::OK;
+        }
+
+        const RegisterImage& front = slots[readSlot];
+        const uint32_t sourceMask = registerRangeMask(REG_MAIN_SOURCE, 1) | registerRangeMask(REG_SECOND_SOURCE, 1);
+        const bool sourceChanged = (ackedMask & sourceMask) != sourceMask ||
+            Fields::MainSource::decode(front[REG_MAIN_SOURCE]) != Fields::MainSource::decode(acked[REG_MAIN_SOURCE]) ||
+            Fields::RearSpeakerSource::decode(front[REG_SECOND_SOURCE]) != Fields::RearSpeakerSource::decode(acked[REG_SECOND_SOURCE]);
+
+        uint32_t sent = 0;
+        const i2cResult result = dev.sendImageRegisters(front, pending, sourceChanged, sent);
+
+        for (uint32_t bits = sent; bits != 0; bits &= bits - 1) {
+            const uint8_t reg = lowestSetBit(bits);
+            acked[reg] = front[reg];
+        }
+        ackedMask |= sent;
+
+        // the device no longer has to send what the chip acknowledged
+        dev.acknowledgeImage(acked, ackedMask & dev.getDirtyMask());
+
+        return result;
+    }
+
+} // namespace TDA7419
@@ -0,0 +1,138 @@
+#include "tda7419SourceSwitcher.hpp"
+#include <Arduino.h>
+
+namespace TDA7419 {
+
+    SourceSwitcher::SourceSwitcher(TDA7419& device) : dev(device) {
+    }
+
+    bool SourceSwitcher::switchSource(InputSource source, uint8_t gain) {
+        return switchSource(source, gain, micros());
+    }
+
+    bool SourceSwitcher::switchSource(InputSource source, uint8_t gain, uint32_t nowMicros) {
+        if (gain > MAX_INPUT_GAIN) {
+            gain = MAX_INPUT_GAIN;
+        }
+        targetSource = source;
+        targetGain = gain;
+
+        switch (state) {
+        case SourceSwitchState::Idle:
+            if (source == dev.getMainSource() && gain == dev.getInputGain()) {
+                return true;
+            }
+            // the soft-mute bit is active-low: getSoftMute() == false means muted
+            keepMuted = !dev.getSoftMute();
+            state = SourceSwitchState::Muting;
+            stepSent = false;
+            break;
+        case SourceSwitchState::Muting:
+            // the new target is picked up by the switch step
+            break;
+        case SourceSwitchState::Settling:
+            // still muted: write the new source and restart AutoZero
+            stepSent = false;
+            break;
+        case SourceSwitchState::Unmuting:
+            state = SourceSwitchState::Muting;
+            stepSent = false;
+            break;
+        }
+
+        update(nowMicros);
+        return false;
+    }
+
+    bool SourceSwitcher::update() {
+        return update(micros());
+    }
+
+    bool SourceSwitcher::update(uint32_t nowMicros) {
+        while (state != SourceSwitchState::Idle) {
+            if (!stepSent) {
+                if (!sendStep()) {
+                    return false;
+                }
+                stepSent = true;
+                stepStartMicros = nowMicros;
+            }
+
+            if (nowMicros - stepStartMicros < stepMicros) {
+                return false;
+            }
+
+            stepSent = false;
+            switch (state) {
+            case SourceSwitchState::Muting:
+                state = SourceSwitchState::Settling;
+                break;
+            case SourceSwitchState::Settling:
+                state = SourceSwitchState::Unmuting;
+                break;
+            default:
+                state = SourceSwitchState::Idle;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    uint32_t SourceSwitcher::getMuteMicros() const {
+        switch (dev.getSoftMuteTime()) {
+        case SoftMuteTime::Ms048:
+            return 480;
+        case SoftMuteTime::Ms096:
+            return 960;
+        default:
+            return 123000;
+        }
+    }
+
+    bool SourceSwitcher::sendStep() {
+        // setters inside beginUpdate()/commit() could still be rolled back
+        if (dev.isUpdating()) {
+            return false;
+        }
+
+        uint8_t reg;
+        switch (state) {
+        case SourceSwitchState::Muting:
+            if (keepMuted) {
+                stepMicros = 0;
+                return true;
+            }
+            dev.setSoftMute(false);
+            reg = REG_SOFT_MUTE_CONTROL;
+            stepMicros = getMuteMicros();
+            break;
+        case SourceSwitchState::Settling:
+            dev.setMainSource(targetSource);
+            dev.setInputGain(targetGain);
+            reg = REG_MAIN_SOURCE;
+            stepMicros = autoZeroMicros;
+            break;
+        default:
+            if (keepMuted) {
+                stepMicros = 0;
+                return true;
+            }
+            dev.setSoftMute(true);
+            reg = REG_SOFT_MUTE_CONTROL;
+            stepMicros = getMuteMicros();
+            break;
+        }
+
+        // one register, one burst; other pending changes are left to the normal flush
+        lastResult = dev.sendChangedRegisters(registerRangeMask(reg, 1));
+        if (lastResult != i2cResult::OK) {
+            return false;
+        }
+
+        // the wait starts when the write has reached the chip
+        stepMicros += dev.burstMicros(1);
+        return true;
+    }
+
+} // namespace TDA7419
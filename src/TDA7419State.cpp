@@ -0,0 +1,284 @@
+#include "tda7419State.hpp"
+
+namespace TDA7419 {
+
+    namespace {
+        // values above this cannot be in range of any parameter; stop accumulating
+        constexpr int16_t TEXT_VALUE_LIMIT = 1000;
+
+        bool isKeyChar(char c) {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+        }
+
+        bool isSpace(char c) {
+            return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+        }
+
+        // ends a value; whitespace also separates "a=1 b=2"
+        bool isTerminator(char c) {
+            return isSpace(c) || c == ',' || c == ';' || c == '}';
+        }
+
+        // ends a rejected pair
+        bool isSeparator(char c) {
+            return c == '\n' || c == ',' || c == ';' || c == '}';
+        }
+    }
+
+    uint8_t formatStateNumber(int16_t value, char* out) {
+        uint8_t length = 0;
+        uint16_t magnitude = static_cast<uint16_t>(value);
+        if (value < 0) {
+            out[length++] = '-';
+            magnitude = static_cast<uint16_t>(-static_cast<int32_t>(value));
+        }
+
+        char digits[5];
+        uint8_t count = 0;
+        do {
+            digits[count++] = static_cast<char>('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude > 0);
+
+        while (count > 0) {
+            out[length++] = digits[--count];
+        }
+        return length;
+    }
+
+    StateParser::StateParser(TDA7419& device) : dev(device) {
+    }
+
+    void StateParser::begin() {
+        if (!active) {
+            dev.beginUpdate();
+            active = true;
+        }
+        step = Step::Detect;
+        applied = 0;
+        rejected = 0;
+    }
+
+    void StateParser::feed(const uint8_t* data, size_t length) {
+        for (size_t i = 0; i < length; ++i) {
+            feed(data[i]);
+        }
+    }
+
+    void StateParser::feed(uint8_t byte) {
+        if (!active) {
+            begin();
+        }
+
+        if (step == Step::Detect) {
+            if (byte == STATE_BINARY_MAGIC) {
+                step = Step::RunId;
+                return;
+            }
+            step = Step::Idle;
+        }
+
+        if (step == Step::RunId || step == Step::RunCount || step == Step::RunValues) {
+            feedBinary(byte);
+        }
+        else {
+            feedText(static_cast<char>(byte));
+        }
+    }
+
+    i2cResult StateParser::end() {
+        if (!active) {
+            return i2cResult::OK;
+        }
+
+        switch (step) {
+        case Step::Number:
+        case Step::Word:
+            // a value ends with the message as well
+            feedText('\n');
+            break;
+        case Step::RunCount:
+        case Step::Key:
+        case Step::AfterKey:
+        case Step::ValueStart:
+            ++rejected;
+            break;
+        case Step::RunValues:
+            rejected += remaining;
+            break;
+        default:
+            break;
+        }
+
+        active = false;
+        step = Step::Detect;
+        return dev.commit();
+    }
+
+    void StateParser::cancel() {
+        if (active) {
+            dev.abort();
+            active = false;
+        }
+        step = Step::Detect;
+    }
+
+    void StateParser::feedBinary(uint8_t byte) {
+        switch (step) {
+        case Step::RunId:
+            paramId = byte;
+            step = Step::RunCount;
+            break;
+        case Step::RunCount:
+            remaining = byte;
+            step = remaining > 0 ? Step::RunValues : Step::RunId;
+            break;
+        default:
+            // values past the last parameter are rejected; the id never wraps back to 0
+            if (paramId < PARAM_COUNT) {
+                value = static_cast<int8_t>(byte);
+                apply();
+                ++paramId;
+            }
+            else {
+                ++rejected;
+            }
+            if (--remaining == 0) {
+                step = Step::RunId;
+            }
+            break;
+        }
+    }
+
+    void StateParser::feedText(char c) {
+        switch (step) {
+        case Step::Idle:
+            if (isKeyChar(c)) {
+                key[0] = c;
+                keyLength = 1;
+                keyOverflow = false;
+                step = Step::Key;
+            }
+            else if (!isSpace(c) && c != '{' && c != '}' && c != ',' && c != ';' && c != '"') {
+                ++rejected;
+                step = Step::Skip;
+            }
+            break;
+
+        case Step::Key:
+            if (isKeyChar(c)) {
+                if (keyLength < PARAM_KEY_MAX) {
+                    key[keyLength++] = c;
+                }
+                else {
+                    keyOverflow = true;
+                }
+            }
+            else if (c == '=' || c == ':') {
+                lookupKey();
+                step = Step::ValueStart;
+            }
+            else if (c == '"' || isSpace(c)) {
+                step = Step::AfterKey;
+            }
+            else {
+                ++rejected;
+                step = isSeparator(c) ? Step::Idle : Step::Skip;
+            }
+            break;
+
+        case Step::AfterKey:
+            if (c == '=' || c == ':') {
+                lookupKey();
+                step = Step::ValueStart;
+            }
+            else if (!isSpace(c) && c != '"') {
+                ++rejected;
+                step = isSeparator(c) ? Step::Idle : Step::Skip;
+            }
+            break;
+
+        case Step::ValueStart:
+            negative = false;
+            value = 0;
+            if (c == '-') {
+                negative = true;
+                step = Step::Number;
+            }
+            else if (c >= '0' && c <= '9') {
+                value = c - '0';
+                step = Step::Number;
+            }
+            else if (c == 't' || c == 'f') {
+                word = c == 't' ? "true" : "false";
+                wordIndex = 1;
+                step = Step::Word;
+            }
+            else if (!isSpace(c) && c != '"') {
+                ++rejected;
+                step = isSeparator(c) ? Step::Idle : Step::Skip;
+            }
+            break;
+
+        case Step::Number:
+            if (c >= '0' && c <= '9') {
+                if (value < TEXT_VALUE_LIMIT) {
+                    value = value * 10 + (c - '0');
+                }
+            }
+            else if (c == '"') {
+                // quoted numbers are accepted as well
+            }
+            else if (isTerminator(c)) {
+                if (negative) {
+                    value = -value;
+                }
+                apply();
+                step = Step::Idle;
+            }
+            else {
+                ++rejected;
+                step = Step::Skip;
+            }
+            break;
+
+        case Step::Word:
+            if (word[wordIndex] != 0 && c == word[wordIndex]) {
+                ++wordIndex;
+            }
+            else if (word[wordIndex] == 0 && (isTerminator(c) || c == '"')) {
+                value = word[0] == 't' ? 1 : 0;
+                apply();
+                step = c == '"' ? Step::Skip : Step::Idle;
+            }
+            else {
+                ++rejected;
+                step = isSeparator(c) ? Step::Idle : Step::Skip;
+            }
+            break;
+
+        case Step::Skip:
+            if (isSeparator(c)) {
+                step = Step::Idle;
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    void StateParser::lookupKey() {
+        paramId = keyOverflow ? PARAM_NONE : findParam(key, keyLength);
+    }
+
+    void StateParser::apply() {
+        if (paramId != PARAM_NONE && setParam(dev, paramId, value)) {
+            ++applied;
+        }
+        else {
+            ++rejected;
+        }
+    }
+
+} // namespace TDA7419
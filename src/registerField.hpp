@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Compile-time descriptor of a contiguous bit-range inside an 8-bit register.
+ *
+ * Position and length are template parameters, so the range is validated at
+ * compile time and mask and shift are constants: there are none of the runtime
+ * bound checks and mask building of bitStorage::writeValueAtBit(). The register
+ * update itself is done by TDA7419::modifyRegister(), which takes the mask as an
+ * argument (a compare-and-swap with TDA7419_CONCURRENT).
+ *
+ * @tparam Pos Starting bit index [0..7] of the field (LSB of the field).
+ * @tparam Len Number of bits in the field [1..8].
+ */
+template<uint8_t Pos, uint8_t Len>
+struct BitField {
+    static_assert(Len > 0, "BitField length must be at least 1 bit");
+    static_assert(Pos <= 7, "BitField position must be in range [0..7]");
+    static_assert(Pos + Len <= 8, "BitField must fit inside an 8-bit register");
+
+    static constexpr uint8_t position = Pos;
+    static constexpr uint8_t length = Len;
+
+    /** @brief Mask of the field bits in place. */
+    static constexpr uint8_t mask = static_cast<uint8_t>(((1u << Len) - 1u) << Pos);
+
+    /**
+     * @brief Shift a right-aligned value into the field position.
+     * @param value Value to encode; bits beyond the field length are dropped.
+     * @return uint8_t Value shifted and masked to the field.
+     */
+    static constexpr uint8_t encode(uint8_t value) {
+        return static_cast<uint8_t>((value << Pos) & mask);
+    }
+
+    /**
+     * @brief Extract the field from a full register value.
+     * @param registerValue Raw 8-bit register value.
+     * @return uint8_t Field value right-aligned.
+     */
+    static constexpr uint8_t decode(uint8_t registerValue) {
+        return static_cast<uint8_t>((registerValue & mask) >> Pos);
+    }
+
+    /**
+     * @brief Replace the field inside a full register value.
+     * @param registerValue Raw 8-bit register value.
+     * @param value Right-aligned field value.
+     * @return uint8_t Register value with the field replaced.
+     */
+    static constexpr uint8_t insert(uint8_t registerValue, uint8_t value) {
+        return static_cast<uint8_t>((registerValue & static_cast<uint8_t>(~mask)) | encode(value));
+    }
+};
@@ -2,8 +2,9 @@
 
 #include <cstdint>
 #include <array>        // added
-#include <Wire.h>
-#include "bitStorage.hpp"
+#include "tda7419Bus.hpp"
+#include "tda7419Atomic.hpp"
+#include "registerField.hpp"
 
 #ifdef TDA7419_DEBUG
 #define DEBUG_PRINT(...) Serial.printf(__VA_ARGS__)
@@ -23,6 +24,31 @@ namespace TDA7419 {
     // number of device registers
     constexpr size_t REGISTER_COUNT = 17;
 
+    // raw copy of the register map (same layout as the driver shadow)
+    using RegisterImage = std::array<uint8_t, REGISTER_COUNT>;
+
+    // one bit per register in the dirty mask
+    constexpr uint32_t ALL_REGISTERS_MASK = (uint32_t(1) << REGISTER_COUNT) - 1;
+
+    /**
+     * @brief Dirty-mask bits covering a contiguous register range.
+     * @param firstIndex Index of the first register.
+     * @param count Number of registers.
+     * @return uint32_t mask with bits [firstIndex, firstIndex + count) set.
+     */
+    constexpr uint32_t registerRangeMask(uint8_t firstIndex, uint8_t count) {
+        return ((uint32_t(1) << count) - 1) << firstIndex;
+    }
+
+    /**
+     * @brief Index of the lowest set bit (count trailing zeros).
+     * @param mask Non-zero mask.
+     * @return uint8_t bit index.
+     */
+    inline uint8_t lowestSetBit(uint32_t mask) {
+        return static_cast<uint8_t>(__builtin_ctzl(static_cast<unsigned long>(mask)));
+    }
+
     // register indices (self-documenting)
     // Replaced enum class RegisterIndex with constexpr uint8_t constants
     constexpr uint8_t REG_MAIN_SOURCE = 0;
@@ -43,6 +69,12 @@ namespace TDA7419 {
     constexpr uint8_t REG_SUBWOOFER_LEVEL = 15;
     constexpr uint8_t REG_SPECTRUM_ANALYZER = 16;
 
+    // registers flushed ahead of the others by default: source, soft-mute and every volume
+    constexpr uint32_t DEFAULT_URGENT_REGISTERS_MASK =
+        registerRangeMask(REG_MAIN_SOURCE, 1) |
+        registerRangeMask(REG_SOFT_MUTE_CONTROL, 2) |
+        registerRangeMask(REG_SPEAKER_LF_LEVEL, 6);
+
     constexpr uint8_t MIN_INPUT_GAIN = 0;
     constexpr uint8_t MAX_INPUT_GAIN = 15;
     constexpr int8_t MIN_SPEAKER_VOLUME = -80;
@@ -50,6 +82,110 @@ namespace TDA7419 {
     constexpr int8_t MIN_EQ_LEVEL = -15;
     constexpr int8_t MAX_EQ_LEVEL = 15;
 
+    // I2C bus cost model used by the flush planner (in SCL bit-times)
+    constexpr uint8_t I2C_BITS_PER_BYTE = 9;        // 8 data bits + ACK
+    constexpr uint8_t I2C_START_STOP_BITS = 2;      // START + STOP condition
+    constexpr uint8_t I2C_BURST_HEADER_BYTES = 2;   // device address + subaddress
+
+    /**
+     * @brief Bytes on the wire for one auto-increment burst.
+     * @param registerCount Number of register data bytes in the burst.
+     * @return uint8_t address + subaddress + data bytes.
+     */
+    constexpr uint8_t burstBytes(uint8_t registerCount) {
+        return I2C_BURST_HEADER_BYTES + registerCount;
+    }
+
+    /**
+     * @brief Bus time of one auto-increment burst in SCL bit-times.
+     * @param registerCount Number of register data bytes in the burst.
+     * @return uint16_t START + (address + subaddress + data) * 9 + STOP.
+     */
+    constexpr uint16_t burstBitTimes(uint8_t registerCount) {
+        return I2C_START_STOP_BITS + static_cast<uint16_t>(burstBytes(registerCount)) * I2C_BITS_PER_BYTE;
+    }
+
+    /**
+     * @brief Compile-time descriptor of a register field.
+     * @tparam Reg Register index [0..REGISTER_COUNT-1].
+     * @tparam Pos Starting bit index of the field.
+     * @tparam Len Number of bits in the field.
+     */
+    template<uint8_t Reg, uint8_t Pos, uint8_t Len>
+    struct Field : BitField<Pos, Len> {
+        static_assert(Reg < REGISTER_COUNT, "Field register index out of range");
+        static constexpr uint8_t reg = Reg;
+    };
+
+    /**
+     * @brief Field descriptors of every setting exposed by the driver.
+     * @details Speaker fields describe the left front register; the channel is added as an offset.
+     */
+    namespace Fields {
+        using MainSource = Field<REG_MAIN_SOURCE, 0, 3>;
+        using InputGain = Field<REG_MAIN_SOURCE, 3, 4>;
+        using AutoZero = Field<REG_MAIN_SOURCE, 7, 1>;
+
+        using LoudnessAttenuation = Field<REG_LOUDNESS_CONTROL, 0, 4>;
+        using LoudnessCenterFreq = Field<REG_LOUDNESS_CONTROL, 4, 2>;
+        using LoudnessHighBoost = Field<REG_LOUDNESS_CONTROL, 6, 1>;
+        using LoudnessSoftStep = Field<REG_LOUDNESS_CONTROL, 7, 1>;
+
+        using SoftMute = Field<REG_SOFT_MUTE_CONTROL, 0, 1>;
+        using MutePinEnable = Field<REG_SOFT_MUTE_CONTROL, 1, 1>;
+        using SoftMuteTime = Field<REG_SOFT_MUTE_CONTROL, 2, 2>;
+        using SoftStepTime = Field<REG_SOFT_MUTE_CONTROL, 4, 3>;
+        using ClockFastMode = Field<REG_SOFT_MUTE_CONTROL, 7, 1>;
+
+        using MasterVolume = Field<REG_MASTER_VOLUME, 0, 7>;
+        using MasterVolumeSoftStep = Field<REG_MASTER_VOLUME, 7, 1>;
+
+        using TrebleLevel = Field<REG_TREBLE_FILTER, 0, 5>;
+        using TrebleCenterFreq = Field<REG_TREBLE_FILTER, 5, 2>;
+        using TrebleReferenceInternal = Field<REG_TREBLE_FILTER, 7, 1>;
+
+        using MiddleLevel = Field<REG_MIDDLE_FILTER, 0, 5>;
+        using MiddleQFactor = Field<REG_MIDDLE_FILTER, 5, 2>;
+        using MiddleSoftStep = Field<REG_MIDDLE_FILTER, 7, 1>;
+
+        using BassLevel = Field<REG_BASS_FILTER, 0, 5>;
+        using BassQFactor = Field<REG_BASS_FILTER, 5, 2>;
+        using BassSoftStep = Field<REG_BASS_FILTER, 7, 1>;
+
+        using SecondSource = Field<REG_SECOND_SOURCE, 0, 3>;
+        using SecondSourceInputGain = Field<REG_SECOND_SOURCE, 3, 4>;
+        using RearSpeakerSource = Field<REG_SECOND_SOURCE, 7, 1>;
+
+        using SubCutoffFreq = Field<REG_SUB_MID_BASS, 0, 2>;
+        using MiddleCenterFreq = Field<REG_SUB_MID_BASS, 2, 2>;
+        using BassCenterFreq = Field<REG_SUB_MID_BASS, 4, 2>;
+        using BassDcMode = Field<REG_SUB_MID_BASS, 6, 1>;
+        using SmoothingFilter = Field<REG_SUB_MID_BASS, 7, 1>;
+
+        using MixToLeftFront = Field<REG_MIXING_CONTROL, 0, 1>;
+        using MixToRightFront = Field<REG_MIXING_CONTROL, 1, 1>;
+        using MixingEnable = Field<REG_MIXING_CONTROL, 2, 1>;
+        using SubwooferEnable = Field<REG_MIXING_CONTROL, 3, 1>;
+        using MixingGainEffect = Field<REG_MIXING_CONTROL, 4, 4>;
+
+        using SpeakerVolume = Field<REG_SPEAKER_LF_LEVEL, 0, 7>;
+        using SpeakerSoftStep = Field<REG_SPEAKER_LF_LEVEL, 7, 1>;
+
+        using MixingChannelVolume = Field<REG_MIXING_LEVEL, 0, 7>;
+        using MixingChannelSoftStep = Field<REG_MIXING_LEVEL, 7, 1>;
+
+        using SubwooferVolume = Field<REG_SUBWOOFER_LEVEL, 0, 7>;
+        using SubwooferSoftStep = Field<REG_SUBWOOFER_LEVEL, 7, 1>;
+
+        using SpectrumFilterQ = Field<REG_SPECTRUM_ANALYZER, 0, 1>;
+        using SpectrumAutoReset = Field<REG_SPECTRUM_ANALYZER, 1, 1>;
+        using SpectrumSource = Field<REG_SPECTRUM_ANALYZER, 2, 1>;
+        using SpectrumRun = Field<REG_SPECTRUM_ANALYZER, 3, 1>;
+        using SpectrumReset = Field<REG_SPECTRUM_ANALYZER, 4, 1>;
+        using ExternalClock = Field<REG_SPECTRUM_ANALYZER, 5, 1>;
+        using SpectrumCouplingMode = Field<REG_SPECTRUM_ANALYZER, 6, 2>;
+    }
+
 #pragma region Enumerations for various settings
     /** 
      * @brief Input source selector.
@@ -197,6 +333,8 @@ namespace TDA7419 {
         RightRear = 3
     };
 
+    constexpr uint8_t SPEAKER_CHANNEL_COUNT = 4;
+
     /**
      * @brief Soft-mute ramp time selection.
      * @details Corresponds to register 2 bits [3:2].
@@ -244,21 +382,130 @@ namespace TDA7419 {
         Timeout = 5
     };
 
+    /**
+     * @brief Flush priority class of a register.
+     */
+    enum class RegisterPriority : uint8_t {
+        Urgent = 0,         // sent before any deferrable register
+        Deferrable = 1      // tone, filter and spectrum settings
+    };
+
 
 #pragma endregion
 
+    /**
+     * @brief Traffic counters filled in by TDA7419::poll().
+     */
+    struct FlushReport {
+        uint16_t transactions = 0;
+        uint16_t bytes = 0;
+        uint16_t errors = 0;
+        uint16_t scrubs = 0;        // transactions that were scrub slices
+    };
+
+#ifdef TDA7419_STATS
+    constexpr uint8_t STATS_RESULT_CODES = 6;                   // i2cResult::OK .. i2cResult::Timeout
+    constexpr uint8_t STATS_LATENCY_BUCKETS = 8;                // <64, <128, ... <4096, >=4096 us
+    constexpr uint32_t STATS_LATENCY_FIRST_BUCKET_MICROS = 64;
+
+    /**
+     * @brief I2C instrumentation counters (only with TDA7419_STATS defined).
+     */
+    struct BusStats {
+        std::array<uint32_t, REGISTER_COUNT> registerWrites{};          // successful writes per register
+        uint32_t transactions = 0;                                      // sendData() calls
+        uint32_t bytesSent = 0;                                         // bytes on the wire incl. address
+        std::array<uint16_t, STATS_RESULT_CODES> resultCounts{};        // sendData() results per i2cResult code
+        std::array<uint16_t, STATS_LATENCY_BUCKETS> latencyHistogram{}; // sendData() duration incl. retries
+        uint32_t maxFlushMicros = 0;                                    // longest sendAll/sendChanged/poll
+    };
+#endif
+
+    /**
+     * @brief Retry behaviour of failed I2C transactions.
+     * @details A failed transaction is repeated up to maxAttempts times in total, waiting
+     * initialBackoffMicros before the first retry and multiplying the wait by
+     * backoffMultiplier (capped at maxBackoffMicros) for each further one.
+     * The wait is blocking, except that TDA7419::poll() skips retries that would overrun
+     * its budget. The default of one attempt disables retries.
+     */
+    struct RetryPolicy {
+        uint8_t maxAttempts = 1;
+        uint8_t backoffMultiplier = 2;
+        uint16_t initialBackoffMicros = 100;
+        uint16_t maxBackoffMicros = 5000;
+    };
+
+    /**
+     * @brief Callback to recover a stuck bus (e.g. pulse SCL nine times and re-init Wire).
+     * @param context User pointer passed to TDA7419::setBusRecovery().
+     * @param error Error that triggered the recovery (Timeout or OtherError).
+     */
+    using BusRecoveryFn = void (*)(void* context, i2cResult error);
+
+    /**
+     * @brief Callback selecting a multiplexer channel.
+     * @param context User pointer passed to BusMux.
+     * @param channel Channel to select.
+     */
+    using BusSelectFn = void (*)(void* context, uint8_t channel);
+
+    /**
+     * @brief I2C multiplexer shared by several devices.
+     * @details Remembers the active channel so consecutive transactions to devices
+     * behind the same channel do not switch the multiplexer again.
+     */
+    class BusMux {
+    public:
+        explicit BusMux(BusSelectFn fn, void* selectContext = nullptr) : selectFn(fn), context(selectContext) {}
+
+        /**
+         * @brief Select a channel unless it is already active.
+         * @param channel Channel to select.
+         */
+        void select(uint8_t channel) {
+            if (channel != active) {
+                selectFn(context, channel);
+                active = channel;
+                ++switches;
+            }
+        }
+
+        /**
+         * @brief Forget the active channel (e.g. after someone else used the multiplexer).
+         */
+        void invalidate() { active = NO_CHANNEL; }
+
+        /**
+         * @brief Number of channel switches performed.
+         * @return uint32_t switch count.
+         */
+        uint32_t getSwitchCount() const { return switches; }
+
+    private:
+        static constexpr uint8_t NO_CHANNEL = 0xFF;
+
+        BusSelectFn selectFn;
+        void* context;
+        uint8_t active = NO_CHANNEL;
+        uint32_t switches = 0;
+    };
+
 
     /**
      * @brief High-level driver for the TDA7419 audio processor.
      * @details Provides setters/getters for all chip features. All methods that
      * read or write device state document the affected register and bit positions.
+     * @note Built with TDA7419_CONCURRENT, setters and getters may be called from any
+     * task or interrupt handler without locking, as long as a single flusher task makes
+     * every call that touches the bus (flushes, poll(), transactions, configuration).
      */
     class TDA7419 {
     public:
         bool debug = false;
 
-        // Construct with an I2C interface (defaults to Wire)
-        TDA7419(TwoWire& wire = Wire);
+        // Construct with a bus backend (defaults to Wire, see tda7419Bus.hpp) and device address (defaults to 0x44)
+        TDA7419(Bus bus = Bus(), uint8_t address = TDA7419_I2C_ADDRESS);
         ~TDA7419();
 
         void begin();
@@ -968,11 +1215,44 @@ namespace TDA7419 {
          */
         void setRegisterValue(uint8_t regIndex, uint8_t value);
         
+        /**
+         * @brief Copy the register shadow.
+         * @param image Destination image.
+         */
+        void getRegisterImage(RegisterImage& image) const {
+            for (uint8_t reg = 0; reg < REGISTER_COUNT; ++reg) {
+                image[reg] = shadow::load(registers[reg]);
+            }
+        }
+
+        /**
+         * @brief Load a complete register image into the shadow.
+         * @param image Source image.
+         * @note Only registers whose value differs are marked dirty, so the next flush
+         * sends just the changed ranges. A source change re-arms the AutoZero sequence
+         * exactly like setMainSource().
+         */
+        void setRegisterImage(const RegisterImage& image);
+
+        /**
+         * @brief Check whether a register is waiting to be sent.
+         * @param regIndex Index of the register.
+         * @return bool true if the register changed since it was last sent.
+         */
+        bool isRegisterDirty(uint8_t regIndex) const { return (shadow::load(dirtyMask) >> regIndex) & 1u; }
+
+        /**
+         * @brief Get the mask of registers waiting to be sent.
+         * @return uint32_t bit n set when register n is pending.
+         */
+        uint32_t getDirtyMask() const { return shadow::load(dirtyMask) & ALL_REGISTERS_MASK; }
+
         /**
          * @brief Send arbitrary data to the device over I2C.
          * @param data Pointer to data buffer.
          * @param length Length of data in bytes.
-         * @return i2cResult result code of the transmission.
+         * @return i2cResult result code of the last attempt.
+         * @note Failed transmissions are retried according to the retry policy.
          */
         i2cResult sendData(const uint8_t* data, size_t length);
 
@@ -989,35 +1269,501 @@ namespace TDA7419 {
          * @brief Send a single register to the device.
          * @param regIndex Index of the register to send.
          * @return bool true on success.
+         * @note Inside an update transaction the register is only queued for the commit.
          */
         i2cResult sendRegister(uint8_t regIndex);
-        
+
+        /**
+         * @brief Send a contiguous range of registers as one auto-increment burst.
+         * @param firstIndex Index of the first register in the range.
+         * @param count Number of registers to send (firstIndex + count <= REGISTER_COUNT).
+         * @return i2cResult result code of the transmission.
+         * @note A single register is sent without the auto-increment bit. Inside an update
+         * transaction the range is only queued for the commit.
+         */
+        i2cResult sendRegisterRange(uint8_t firstIndex, uint8_t count);
+
 
         /**
          * @brief Send the entire cached register map to the device.
-         * @return bool true on success.
-         * @note Writes registers 0..(REGISTER_COUNT-1).
+         * @return i2cResult result code of the transmission.
+         * @note Writes registers 0..(REGISTER_COUNT-1). Inside an update transaction the
+         * registers are only queued (see queueAllRegisters()): the commit sends them, abort()
+         * drops them with the rest of the transaction.
          */
         i2cResult sendAllRegisters();
 
         /**
          * @brief Send only registers that have changed since last transmission.
-         * @return bool true on success.
+         * @param registerMask Registers allowed to go out (default all); changed registers
+         * outside the mask stay pending.
+         * @return i2cResult OK, or the first error; registers of failed bursts stay pending.
          * @note Optimizes I2C traffic by using internal changed-flag bookkeeping.
+         * Contiguous changed registers are coalesced into auto-increment bursts, and
+         * small unchanged gaps are filled in when that costs fewer bus bit-times.
+         * Urgent registers go out first (see setRegisterPriority()). A burst never carries
+         * a pending register of the other priority class, but a gap it bridges may include
+         * unchanged registers of either class.
          */
-        i2cResult sendChangedRegisters();
+        i2cResult sendChangedRegisters(uint32_t registerMask = ALL_REGISTERS_MASK);
+
+        /**
+         * @brief Send registers of a caller-supplied image instead of the shadow.
+         * @param image Register values to send.
+         * @param registerMask Registers to send.
+         * @param autoZeroRemain Set the AutoZero remain bit on the burst that writes register 0
+         * (source change).
+         * @param sentMask Receives the registers written successfully, including the
+         * unchanged ones that filled a gap inside a burst.
+         * @return i2cResult OK, or the first error.
+         * @note Bursts are planned as in sendChangedRegisters(); the shadow and its dirty
+         * mask are left alone (see acknowledgeImage()). Used by ImagePublisher.
+         */
+        i2cResult sendImageRegisters(const RegisterImage& image, uint32_t registerMask, bool autoZeroRemain, uint32_t& sentMask);
+
+        /**
+         * @brief Mark registers as sent because the chip holds their shadow value.
+         * @param image Register values the chip has acknowledged.
+         * @param registerMask Registers of @p image known to be on the chip.
+         * @note Clears the pending state of every register in the mask whose shadow value
+         * equals @p image; one changed since stays pending. Flusher side, used by
+         * ImagePublisher so isFlushPending() and poll() do not resend its work.
+         */
+        void acknowledgeImage(const RegisterImage& image, uint32_t registerMask);
+
+        /**
+         * @brief Queue the entire register map for the non-blocking flush engine.
+         * @note Non-blocking counterpart of sendAllRegisters(); the registers are sent by poll().
+         */
+        void queueAllRegisters();
+
+        /**
+         * @brief Send pending registers within a time budget.
+         * @param budgetMicros Bus time available for this call in microseconds.
+         * @return i2cResult OK, or the first error; registers of failed bursts stay pending.
+         * @note Call from loop(). Each call sends at most as many bursts as fit in the budget
+         * (estimated from the bus clock, see setBusClock()) and resumes on the next call; a
+         * run that does not fit is split so its first registers still go out. A budget too
+         * small for a single register sends nothing. Urgent registers are sent before
+         * deferrable ones, so a tight budget never holds a volume change behind tone writes.
+         * Once nothing is pending, the remaining budget may be used for one scrub slice
+         * (see setScrubBudget()). Retries (see setRetryPolicy()) are made only while the
+         * backoff and the repeated burst fit in the budget; otherwise the burst stays
+         * pending and is retried by the next call. A budget of 0x80000000 or more does not
+         * limit retries.
+         * @param report Optional counters incremented with the traffic of this call.
+         */
+        i2cResult poll(uint32_t budgetMicros, FlushReport* report = nullptr);
+
+        /**
+         * @brief Set the flush priority class of a register.
+         * @param regIndex Register index.
+         * @param priority Urgent or Deferrable.
+         * @note By default source (0), soft-mute (2) and the volumes (3, 10..15) are urgent;
+         * tone, filter and spectrum registers are deferrable.
+         */
+        void setRegisterPriority(uint8_t regIndex, RegisterPriority priority);
+
+        /**
+         * @brief Get the flush priority class of a register.
+         * @param regIndex Register index.
+         * @return RegisterPriority class of the register.
+         */
+        RegisterPriority getRegisterPriority(uint8_t regIndex) const;
+
+        /**
+         * @brief Set the priority classes of all registers at once.
+         * @param registerMask Bit n set: register n is urgent.
+         */
+        void setUrgentRegisters(uint32_t registerMask) { urgentMask = registerMask & ALL_REGISTERS_MASK; }
+        uint32_t getUrgentRegisters() const { return urgentMask; }
+
+        /**
+         * @brief Enable background scrubbing of the register image.
+         * @param permille Share of bus time the scrubber may use, in 1/1000 (20 = 2%); 0 disables it.
+         * @param sliceRegisters Registers re-sent per scrub burst [1..REGISTER_COUNT].
+         * @note The chip is write-only, so a brown-out reset is invisible to the driver. The
+         * scrubber re-sends the shadow in rotating auto-increment slices from poll(), only when
+         * no register is pending, so user changes always go first. Bus time is metered with a
+         * token bucket one slice deep, so the long-run share never exceeds the budget.
+         * Slices that start at register 0 set the AutoZero remain bit, so refreshing the
+         * source does not mute the output.
+         */
+        void setScrubBudget(uint16_t permille, uint8_t sliceRegisters = 4);
+
+        /**
+         * @brief Get the scrub budget.
+         * @return uint16_t share of bus time in 1/1000, 0 if disabled.
+         */
+        uint16_t getScrubBudget() const { return scrubPermille; }
+
+        /**
+         * @brief Number of complete passes of the scrubber over all registers.
+         * @return uint32_t scrub cycle count.
+         */
+        uint32_t getScrubCycles() const { return scrubCycles; }
+
+        /**
+         * @brief Check whether the flush engine still has registers to send.
+         * @return bool true while any register is waiting to be sent.
+         */
+        bool isFlushPending() const { return getDirtyMask() != 0; }
+
+        /**
+         * @brief Get the 7-bit I2C address of this device.
+         * @return uint8_t device address.
+         */
+        uint8_t getAddress() const { return i2cAddress; }
+
+        /**
+         * @brief Set the 7-bit I2C address of this device.
+         * @param address Device address.
+         */
+        void setAddress(uint8_t address) { i2cAddress = address; }
+
+        /**
+         * @brief Route this device through an I2C multiplexer.
+         * @param busMux Multiplexer shared by the devices behind it (nullptr to disable).
+         * @param channel Multiplexer channel of this device.
+         * @note The channel is selected before every transaction; BusMux skips the
+         * switch when the channel is already active.
+         */
+        void setBusMux(BusMux* busMux, uint8_t channel);
+
+        /**
+         * @brief Get the multiplexer this device is routed through.
+         * @return BusMux* multiplexer or nullptr.
+         */
+        BusMux* getBusMux() const { return mux; }
+
+        /**
+         * @brief Get the multiplexer channel of this device.
+         * @return uint8_t channel.
+         */
+        uint8_t getBusMuxChannel() const { return muxChannel; }
+
+        /**
+         * @brief Set the retry policy for failed transactions.
+         * @param policy Attempts and backoff timing.
+         */
+        void setRetryPolicy(const RetryPolicy& policy) { retryPolicy = policy; }
+
+        /**
+         * @brief Get the retry policy.
+         * @return const RetryPolicy& current policy.
+         */
+        const RetryPolicy& getRetryPolicy() const { return retryPolicy; }
+
+        /**
+         * @brief Install a bus recovery hook called before retrying a timeout or bus error.
+         * @param recoveryFn Recovery callback (nullptr to remove).
+         * @param context User pointer passed to the callback.
+         */
+        void setBusRecovery(BusRecoveryFn recoveryFn, void* context = nullptr);
+
+        /**
+         * @brief Set the I2C clock used to estimate bus time for poll().
+         * @param hz Bus clock in Hz (should match TwoWire::setClock()).
+         */
+        void setBusClock(uint32_t hz) { busClockHz = hz; }
+
+        /**
+         * @brief Get the I2C clock used to estimate bus time.
+         * @return uint32_t bus clock in Hz.
+         */
+        uint32_t getBusClock() const { return busClockHz; }
+
+        /**
+         * @brief Estimated bus time of one burst at the configured bus clock.
+         * @param registerCount Number of registers in the burst.
+         * @return uint32_t microseconds, rounded up.
+         */
+        uint32_t burstMicros(uint8_t registerCount) const;
+
+        /**
+         * @brief Estimated bus time of a flush of the given registers.
+         * @param registerMask Dirty-mask bits of the registers to send.
+         * @return uint32_t microseconds of all bursts the flush is planned into, with the
+         * current urgent registers (see setUrgentRegisters()).
+         */
+        uint32_t flushMicros(uint32_t registerMask) const;
+
+        /**
+         * @brief Open an update transaction.
+         * @note Until the matching commit() changes only accumulate in the shadow registers;
+         * sendChangedRegisters() and poll() do not send anything, and sendRegister(),
+         * sendRegisterRange() and sendAllRegisters() only queue their registers, so the chip
+         * never sees a value abort() could roll back. Transactions nest: only the
+         * outermost commit() sends. The register image at the outermost beginUpdate() is kept
+         * for abort().
+         */
+        void beginUpdate();
+
+        /**
+         * @brief Close an update transaction.
+         * @return i2cResult result of the flush, OK for an inner (nested) commit.
+         * @note The outermost commit sends every accumulated change as sendChangedRegisters()
+         * does: urgent registers first, then deferrable ones, each class in ascending register
+         * order. Register 2 (soft-mute/soft-step timing) is urgent by default, so it precedes
+         * the level registers whose ramps it controls; keep it urgent when reclassifying.
+         */
+        i2cResult commit();
+
+        /**
+         * @brief Discard the open transaction and restore the last committed register image.
+         * @note Aborting at any nesting level rolls back the outermost transaction.
+         * With concurrent setters this also drops changes made by other contexts meanwhile.
+         */
+        void abort();
+
+        /**
+         * @brief Check whether an update transaction is open.
+         * @return bool true between beginUpdate() and the outermost commit()/abort().
+         */
+        bool isUpdating() const { return updateDepth > 0; }
 
         /**
          * @brief Print register contents to the configured debug output if enabled.
          */
         void printRegistersDebug() const;
 
+#ifdef TDA7419_STATS
+        /**
+         * @brief Snapshot of the I2C instrumentation counters.
+         * @return BusStats copy of the counters.
+         */
+        BusStats getBusStats() const { return busStats; }
+
+        /**
+         * @brief Reset the I2C instrumentation counters.
+         */
+        void resetBusStats();
+
+        /**
+         * @brief Print the I2C instrumentation counters to Serial.
+         */
+        void printBusStats() const;
+#endif
+
+        /**
+         * @brief Access the bus backend.
+         * @return Bus& backend selected with TDA7419_BUS_TYPE.
+         */
+        Bus& getBus() { return bus; }
+        const Bus& getBus() const { return bus; }
+
     private:
-        // I2C interface used to communicate with the device
-        TwoWire& i2c;
+        // Bus backend used to communicate with the device
+        Bus bus;
+        uint8_t i2cAddress;
+
+        // Optional multiplexer in front of the device
+        BusMux* mux = nullptr;
+        uint8_t muxChannel = 0;
 
+        // Error handling
+        RetryPolicy retryPolicy;
+        BusRecoveryFn busRecovery = nullptr;
+        void* busRecoveryContext = nullptr;
 
-        std::array<bitStorage, REGISTER_COUNT> registers;
+        // End of the running poll() budget; retries that do not fit before it are skipped
+        uint32_t retryDeadline = 0;
+        bool retryBounded = false;
+
+        /**
+         * @brief Perform one I2C write transaction (no retries).
+         * @param data Pointer to data buffer.
+         * @param length Length of data in bytes.
+         * @return i2cResult result code of the transmission.
+         */
+        i2cResult transmit(const uint8_t* data, size_t length);
+
+        /**
+         * @brief Retry a failed transmission according to the retry policy.
+         * @param data Pointer to data buffer.
+         * @param length Length of data in bytes.
+         * @param result Result of the first attempt.
+         * @return i2cResult result code of the last attempt.
+         */
+        i2cResult retry(const uint8_t* data, size_t length, i2cResult result);
+
+        /**
+         * @brief Send several bursts in one bus submission, then retry failed ones.
+         * @param messages Bursts to send.
+         * @param count Number of bursts.
+         * @param results Receives the result of every burst.
+         */
+        void sendBatch(const BusMessage* messages, uint8_t count, i2cResult* results);
+
+#ifdef TDA7419_STATS
+        void recordTransmission(size_t length, i2cResult result, uint32_t latencyMicros);
+        void recordRegisterWrites(uint8_t firstIndex, uint8_t count);
+        void recordFlushDuration(uint32_t durationMicros);
+#endif
+
+
+        // Register shadow, one byte per device register
+        std::array<uint8_t, REGISTER_COUNT> registers;
+
+        // Bit n set: register n differs from what was last sent to the device;
+        // INPUT_CHANGED_FLAG: the next burst that writes register 0 carries the AutoZero remain bit
+        uint32_t dirtyMask = 0;
+
+        // Set with a source change, consumed by the burst that sends register 0
+        static constexpr uint32_t INPUT_CHANGED_FLAG = uint32_t(1) << 31;
+
+        // Bit n set: register n is flushed ahead of the deferrable ones
+        uint32_t urgentMask = DEFAULT_URGENT_REGISTERS_MASK;
+
+        /**
+         * @brief Replace some bits of a register and mark it dirty if it actually changed.
+         * @param regIndex Index of the register.
+         * @param mask Bits to replace.
+         * @param bits New value of the masked bits.
+         * @param flags Extra dirty-mask flags raised together with the register bit.
+         * @note Lock-free with TDA7419_CONCURRENT (see tda7419Atomic.hpp).
+         */
+        void modifyRegister(uint8_t regIndex, uint8_t mask, uint8_t bits, uint32_t flags = 0);
+
+        /**
+         * @brief Store a register value and mark it dirty if it actually changed.
+         * @param regIndex Index of the register.
+         * @param value New 8-bit register value.
+         * @param flags Extra dirty-mask flags raised together with the register bit.
+         */
+        void storeRegister(uint8_t regIndex, uint8_t value, uint32_t flags = 0) {
+            modifyRegister(regIndex, 0xFF, value, flags);
+        }
+
+        /**
+         * @brief Take pending registers over for sending (flusher side).
+         * @param registerMask Registers to claim.
+         * @return uint32_t claimed registers; INPUT_CHANGED_FLAG is included when it was
+         * consumed along with register 0.
+         * @note Bits are cleared before the registers are read, so a setter running
+         * during the transfer marks its register dirty again. Put the claimed bits
+         * back with releaseDirty() if the transfer fails.
+         */
+        uint32_t claimDirty(uint32_t registerMask);
+
+        /**
+         * @brief Mark registers pending again after a failed transfer.
+         * @param claimedMask Bits returned by claimDirty().
+         */
+        void releaseDirty(uint32_t claimedMask) { shadow::fetchOr(dirtyMask, claimedMask); }
+
+        /**
+         * @brief Whether the burst that writes register 0 carries the AutoZero remain bit.
+         * @param claimedMask Bits returned by claimDirty().
+         * @return bool true if a source change was claimed along with register 0.
+         */
+        bool autoZeroRemain(uint32_t claimedMask) const {
+            return (claimedMask & INPUT_CHANGED_FLAG) != 0;
+        }
+
+        /**
+         * @brief Write a field described at compile time.
+         * @tparam F Field descriptor (see Fields).
+         * @param value Right-aligned field value.
+         * @param regOffset Offset added to the field register (speaker channel).
+         * @param flags Extra dirty-mask flags raised together with the register bit.
+         */
+        template<class F>
+        void writeField(uint8_t value, uint8_t regOffset = 0, uint32_t flags = 0) {
+            modifyRegister(F::reg + regOffset, F::mask, F::encode(value), flags);
+        }
+
+        /**
+         * @brief Read a field described at compile time.
+         * @tparam F Field descriptor (see Fields).
+         * @param regOffset Offset added to the field register (speaker channel).
+         * @return uint8_t Right-aligned field value.
+         */
+        template<class F>
+        uint8_t readField(uint8_t regOffset = 0) const {
+            return F::decode(shadow::load(registers[F::reg + regOffset]));
+        }
+
+        /**
+         * @brief A contiguous range of registers sent in a single burst.
+         */
+        struct RegisterRun {
+            uint8_t first;
+            uint8_t count;
+        };
+
+        /**
+         * @brief Plan the bursts needed to flush the changed registers.
+         * @param runs Output array with room for REGISTER_COUNT entries.
+         * @param pendingMask Changed registers to send.
+         * @param withheldMask Changed registers that must not be sent.
+         * @return uint8_t number of runs written to @p runs.
+         * @note Two neighbouring runs are merged across a gap of unchanged registers
+         * whenever one burst costs no more bit-times than two (see burstBitTimes()).
+         * A gap holding a withheld register is never filled.
+         */
+        uint8_t planChangedRuns(RegisterRun* runs, uint32_t pendingMask, uint32_t withheldMask) const;
+
+        /**
+         * @brief Plan a flush: the urgent runs first, then the deferrable ones.
+         * @param runs Output array with room for REGISTER_COUNT entries.
+         * @param pendingMask Changed registers to send.
+         * @param withheldMask Changed registers that must not be sent.
+         * @return uint8_t number of runs written to @p runs.
+         */
+        uint8_t planFlush(RegisterRun* runs, uint32_t pendingMask, uint32_t withheldMask) const;
+
+        /**
+         * @brief Send planned runs in one bus submission.
+         * @param runs Runs to send.
+         * @param runCount Number of runs.
+         * @param image Register values, indexed by register.
+         * @param autoZero Set the AutoZero remain bit on the run starting at register 0.
+         * @param results Receives the result of every run.
+         */
+        void sendRuns(const RegisterRun* runs, uint8_t runCount, const uint8_t* image, bool autoZero, i2cResult* results);
+
+        /**
+         * @brief Number of registers of a burst that fit in a time budget.
+         * @param budgetMicros Available bus time in microseconds.
+         * @param maxCount Upper limit (length of the run).
+         * @return uint8_t registers that fit, 0 if not even one does.
+         */
+        uint8_t registersWithinBudget(uint32_t budgetMicros, uint8_t maxCount) const;
+
+        // Bus clock used for time estimates (poll budget)
+        uint32_t busClockHz = 100000;
+
+        // Background scrubber: budget, token bucket and position in the register map
+        uint16_t scrubPermille = 0;
+        uint8_t scrubSlice = 4;
+        uint8_t scrubCursor = 0;
+        uint32_t scrubCreditMicros = 0;
+        uint32_t scrubLastMicros = 0;
+        uint32_t scrubCycles = 0;
+
+        /**
+         * @brief Send one scrub slice if the token bucket and the poll budget allow it.
+         * @param budgetMicros Bus time left in the current poll() call.
+         * @param report Optional counters of the current poll() call.
+         * @return i2cResult result of the slice, OK if none was sent.
+         */
+        i2cResult scrub(uint32_t budgetMicros, FlushReport* report);
+
+        /**
+         * @brief Send a contiguous range of registers (auto-increment if more than one).
+         * @param firstIndex Index of the first register in the range.
+         * @param count Number of registers to send (firstIndex + count <= REGISTER_COUNT).
+         * @param refresh true for a scrub rewrite: a range starting at register 0 always
+         * carries the AutoZero remain bit, so refreshing the source does not mute the output.
+         * @return i2cResult result code of the transmission.
+         */
+        i2cResult sendRange(uint8_t firstIndex, uint8_t count, bool refresh);
+
+        // Update transaction nesting level and the image to roll back to
+        uint8_t updateDepth = 0;
+        std::array<uint8_t, REGISTER_COUNT> committedRegisters;
+        uint32_t committedDirtyMask = 0;
 
         /**
          * @brief Convert user-level volume (dB-equivalent) to 7-bit register encoding.
@@ -1055,8 +1801,52 @@ namespace TDA7419 {
          */
         void printTransmissionError(uint8_t errorCode) const;
 
-        bool inputChanged = true;
+#ifdef TDA7419_STATS
+        // Kept last so the other members have the same offsets with and without TDA7419_STATS
+        BusStats busStats;
+#endif
+    };
+
+    /**
+     * @brief RAII guard for an update transaction.
+     * @details Calls beginUpdate() on construction and commit() on destruction unless
+     * commit() or abort() was called explicitly.
+     */
+    class UpdateGuard {
+    public:
+        explicit UpdateGuard(TDA7419& device) : dev(device) {
+            dev.beginUpdate();
+        }
+
+        ~UpdateGuard() {
+            if (open) {
+                dev.commit();
+            }
+        }
 
+        UpdateGuard(const UpdateGuard&) = delete;
+        UpdateGuard& operator=(const UpdateGuard&) = delete;
+
+        /**
+         * @brief Commit the transaction now.
+         * @return i2cResult result of TDA7419::commit().
+         */
+        i2cResult commit() {
+            open = false;
+            return dev.commit();
+        }
+
+        /**
+         * @brief Roll back the transaction now.
+         */
+        void abort() {
+            open = false;
+            dev.abort();
+        }
+
+    private:
+        TDA7419& dev;
+        bool open = true;
     };
 
 } // namespace TDA7419
\ No newline at end of file
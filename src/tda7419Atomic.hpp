@@ -0,0 +1,108 @@
+#pragma once
+
+#include <stdint.h>
+
+#if defined(TDA7419_CONCURRENT) && defined(__AVR__)
+#include <util/atomic.h>
+#endif
+
+/*
+ * Access primitives for the register shadow and the dirty mask.
+ *
+ * Define TDA7419_CONCURRENT to call setters from any context (interrupt handlers,
+ * RTOS tasks) while a single flusher task owns the bus: every setter is then a
+ * lock-free compare-and-swap on its register byte plus an atomic OR into the dirty
+ * mask, and the flusher claims dirty bits before it reads the registers, so a value
+ * changed during a flush is sent again by the next one. Targets without native
+ * atomics (AVR) run the same operations with interrupts briefly disabled.
+ * Without TDA7419_CONCURRENT they compile to plain loads and stores.
+ */
+
+namespace TDA7419 {
+    namespace shadow {
+
+#if defined(TDA7419_CONCURRENT) && defined(__AVR__)
+        template<class T>
+        inline T load(const T& value) {
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+                return value;
+            }
+            return value;
+        }
+
+        template<class T>
+        inline bool compareExchange(T& value, T& expected, T desired) {
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+                if (value != expected) {
+                    expected = value;
+                    return false;
+                }
+                value = desired;
+            }
+            return true;
+        }
+
+        inline void fetchOr(uint32_t& value, uint32_t bits) {
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+                value |= bits;
+            }
+        }
+
+        template<class T>
+        inline T exchange(T& value, T desired) {
+            T previous;
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+                previous = value;
+                value = desired;
+            }
+            return previous;
+        }
+#elif defined(TDA7419_CONCURRENT)
+        template<class T>
+        inline T load(const T& value) {
+            return __atomic_load_n(&value, __ATOMIC_ACQUIRE);
+        }
+
+        template<class T>
+        inline bool compareExchange(T& value, T& expected, T desired) {
+            return __atomic_compare_exchange_n(&value, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+        }
+
+        inline void fetchOr(uint32_t& value, uint32_t bits) {
+            __atomic_fetch_or(&value, bits, __ATOMIC_ACQ_REL);
+        }
+
+        template<class T>
+        inline T exchange(T& value, T desired) {
+            return __atomic_exchange_n(&value, desired, __ATOMIC_ACQ_REL);
+        }
+#else
+        template<class T>
+        inline T load(const T& value) {
+            return value;
+        }
+
+        template<class T>
+        inline bool compareExchange(T& value, T& expected, T desired) {
+            if (value != expected) {
+                expected = value;
+                return false;
+            }
+            value = desired;
+            return true;
+        }
+
+        inline void fetchOr(uint32_t& value, uint32_t bits) {
+            value |= bits;
+        }
+
+        template<class T>
+        inline T exchange(T& value, T desired) {
+            const T previous = value;
+            value = desired;
+            return previous;
+        }
+#endif
+
+    } // namespace shadow
+} // namespace TDA7419
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <cstdint>
+#include <stddef.h>
+
+// WireBus, and with it <Wire.h>, is only compiled when it is the backend
+#if !defined(TDA7419_BUS_TYPE) && !defined(TDA7419_WIRE_BUS)
+#define TDA7419_WIRE_BUS
+#endif
+
+#ifdef TDA7419_WIRE_BUS
+#include <Wire.h>
+#endif
+
+#if defined(__linux__)
+#include <cerrno>
+#include <fcntl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+/*
+ * Bus backends of the TDA7419 driver.
+ *
+ * The backend is chosen at compile time with TDA7419_BUS_TYPE (default
+ * TDA7419::WireBus) and stored by value in every TDA7419, so calls are resolved
+ * statically and inline; there is no virtual dispatch. A backend provides:
+ *
+ *   uint8_t write(uint8_t address, const uint8_t* data, size_t length);
+ *   void writeBatch(uint8_t address, const BusMessage* messages, uint8_t count, uint8_t* status);
+ *
+ * Status codes follow TwoWire::endTransmission() (0 = OK .. 5 = timeout).
+ * writeBatch() sends several bursts to one device and reports a status per
+ * message; a backend without native batching simply loops over write().
+ * Define TDA7419_BUS_TYPE (and TDA7419_BUS_HEADER, if the backend lives in
+ * another header) the same way for every translation unit. With another backend
+ * selected, WireBus is left out so targets without Wire.h build as well; define
+ * TDA7419_WIRE_BUS to keep it (e.g. for a backend that wraps it).
+ */
+
+namespace TDA7419 {
+
+    /**
+     * @brief One write burst of a batch.
+     */
+    struct BusMessage {
+        const uint8_t* data;
+        uint8_t length;
+    };
+
+#ifdef TDA7419_WIRE_BUS
+    /**
+     * @brief Arduino TwoWire backend (default).
+     */
+    class WireBus {
+    public:
+        /**
+         * @brief Wrap a TwoWire interface.
+         * @param wire Interface to use; converts implicitly, so TDA7419(Wire1) keeps working.
+         */
+        WireBus(TwoWire& wire = Wire) : i2c(&wire) {}
+
+        uint8_t write(uint8_t address, const uint8_t* data, size_t length) {
+            i2c->beginTransmission(address);
+            i2c->write(data, length);
+            return i2c->endTransmission();
+        }
+
+        void writeBatch(uint8_t address, const BusMessage* messages, uint8_t count, uint8_t* status) {
+            for (uint8_t i = 0; i < count; ++i) {
+                status[i] = write(address, messages[i].data, messages[i].length);
+            }
+        }
+
+        TwoWire& getWire() const { return *i2c; }
+
+    private:
+        TwoWire* i2c;
+    };
+#endif
+
+#if defined(__linux__)
+    /**
+     * @brief Linux i2c-dev backend (/dev/i2c-N).
+     * @details Every write is an I2C_RDWR ioctl; writeBatch() submits all bursts of a
+     * flush in one ioctl (chained with repeated START), so a flush costs one system
+     * call instead of one per burst. The file descriptor is owned by the caller.
+     */
+    class LinuxI2CBus {
+    public:
+        /**
+         * @brief Wrap an open i2c-dev file descriptor.
+         * @param fd Descriptor from open(), e.g. LinuxI2CBus::open("/dev/i2c-1").
+         */
+        LinuxI2CBus(int fd = -1) : fd(fd) {}
+
+        /**
+         * @brief Open an i2c-dev adapter.
+         * @param path Device node, e.g. "/dev/i2c-1".
+         * @return int file descriptor, or -1 with errno set.
+         */
+        static int open(const char* path) { return ::open(path, O_RDWR | O_CLOEXEC); }
+
+        uint8_t write(uint8_t address, const uint8_t* data, size_t length) {
+            i2c_msg message = { address, 0, static_cast<uint16_t>(length), const_cast<uint8_t*>(data) };
+            return submit(&message, 1);
+        }
+
+        void writeBatch(uint8_t address, const BusMessage* messages, uint8_t count, uint8_t* status) {
+            i2c_msg chunk[I2C_RDWR_IOCTL_MAX_MSGS];
+            uint8_t done = 0;
+            while (done < count) {
+                uint8_t n = count - done;
+                if (n > I2C_RDWR_IOCTL_MAX_MSGS) {
+                    n = I2C_RDWR_IOCTL_MAX_MSGS;
+                }
+                for (uint8_t i = 0; i < n; ++i) {
+                    const BusMessage& message = messages[done + i];
+                    chunk[i] = { address, 0, message.length, const_cast<uint8_t*>(message.data) };
+                }
+
+                // the kernel reports one result for the whole chain
+                const uint8_t result = submit(chunk, n);
+                for (uint8_t i = 0; i < n; ++i) {
+                    status[done + i] = result;
+                }
+                done += n;
+            }
+        }
+
+        int getFd() const { return fd; }
+
+        /**
+         * @brief Number of ioctl calls issued so far.
+         * @return uint32_t system call count.
+         */
+        uint32_t getSubmissionCount() const { return submissions; }
+
+    private:
+        int fd;
+        uint32_t submissions = 0;
+
+        uint8_t submit(i2c_msg* messages, uint8_t count) {
+            i2c_rdwr_ioctl_data request = { messages, count };
+            ++submissions;
+            if (::ioctl(fd, I2C_RDWR, &request) >= 0) {
+                return 0;
+            }
+
+            // Documentation/i2c/fault-codes.rst
+            switch (errno) {
+            case ENXIO:
+                return 2;
+            case EREMOTEIO:
+                return 3;
+            case ETIMEDOUT:
+                return 5;
+            default:
+                return 4;
+            }
+        }
+    };
+#endif
+
+} // namespace TDA7419
+
+#ifdef TDA7419_BUS_HEADER
+#include TDA7419_BUS_HEADER
+#endif
+
+#ifndef TDA7419_BUS_TYPE
+#define TDA7419_BUS_TYPE ::TDA7419::WireBus
+#endif
+
+namespace TDA7419 {
+    // bus backend compiled into TDA7419
+    using Bus = TDA7419_BUS_TYPE;
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "tda7419.hpp"
+
+namespace TDA7419 {
+
+    constexpr uint8_t COALESCE_GROUP_COUNT = 4;
+
+    /**
+     * @brief Rate limiter for flushes driven by high-frequency UI input.
+     * @details Setters keep writing the shadow as often as they like; intermediate
+     * values simply overwrite each other there (last writer wins). Call update() from
+     * loop() instead of sendChangedRegisters(): changed registers of a group go out at
+     * most once per group interval, everything outside the groups goes out on every
+     * update(). The first change after a quiet period is sent right away; the ones
+     * after it wait for the interval to elapse. A changed register therefore reaches
+     * the chip at most interval + update period + one flush after it was set (see
+     * getLatencyBoundMicros()), as long as the bus does not fail.
+     */
+    class FlushCoalescer {
+    public:
+        /**
+         * @brief Construct a coalescer for a device.
+         * @param device Device whose changed registers are flushed.
+         */
+        explicit FlushCoalescer(TDA7419& device);
+
+        /**
+         * @brief Configure a register group.
+         * @param index Group slot [0..COALESCE_GROUP_COUNT-1].
+         * @param registerMask Registers of the group, e.g. registerRangeMask(REG_SPEAKER_LF_LEVEL, 4).
+         * @param minIntervalMicros Minimum time between two flushes of the group; 0 disables limiting.
+         * @return bool false if the slot does not exist.
+         */
+        bool setGroup(uint8_t index, uint32_t registerMask, uint32_t minIntervalMicros);
+
+        /**
+         * @brief Configure a register group by its maximum update rate.
+         * @param index Group slot [0..COALESCE_GROUP_COUNT-1].
+         * @param registerMask Registers of the group.
+         * @param maxUpdatesPerSecond Flushes per second allowed for the group; 0 disables limiting.
+         * @return bool false if the slot does not exist.
+         */
+        bool setGroupRate(uint8_t index, uint32_t registerMask, uint16_t maxUpdatesPerSecond);
+
+        /**
+         * @brief Remove a register group; its registers are flushed on every update().
+         * @param index Group slot.
+         */
+        void clearGroup(uint8_t index);
+
+        /**
+         * @brief Flush the changed registers whose group interval has elapsed.
+         * @param nowMicros Current time (defaults to micros()).
+         * @return i2cResult OK, or the first error of the flush; failed registers stay pending.
+         * @note Nothing is sent inside beginUpdate()/commit().
+         */
+        i2cResult update(uint32_t nowMicros);
+        i2cResult update();
+
+        /**
+         * @brief Changed registers held back by the last update().
+         * @return uint32_t dirty-mask bits waiting for their group interval.
+         */
+        uint32_t getHeldMask() const { return held; }
+
+        /**
+         * @brief Worst-case delay from setting a register to its write on the chip.
+         * @param regIndex Register index.
+         * @param updatePeriodMicros Longest time between two update() calls.
+         * @return uint32_t bound in microseconds: longest group interval of the register,
+         * plus the update period, plus one flush of the whole register image as it is
+         * planned with the current urgent registers.
+         */
+        uint32_t getLatencyBoundMicros(uint8_t regIndex, uint32_t updatePeriodMicros) const;
+
+    private:
+        struct Group {
+            uint32_t mask;
+            uint32_t intervalMicros;
+            uint32_t lastFlushMicros;
+        };
+
+        TDA7419& dev;
+        std::array<Group, COALESCE_GROUP_COUNT> groups;
+        uint32_t held = 0;
+    };
+
+} // namespace TDA7419
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "tda7419.hpp"
+
+namespace TDA7419 {
+
+    /**
+     * @brief Volume stages handled by the fader.
+     */
+    enum class FadeChannel : uint8_t {
+        Master = 0,
+        LeftFront = 1,
+        RightFront = 2,
+        LeftRear = 3,
+        RightRear = 4,
+        Mixing = 5,
+        Subwoofer = 6
+    };
+
+    constexpr uint8_t FADE_CHANNEL_COUNT = 7;
+
+    // longest fade: 2^31 us, half the micros() range, so the end is never missed across a wrap
+    constexpr uint32_t MAX_FADE_DURATION_MS = 2147483UL;
+
+    /**
+     * @brief Shape of a fade over its duration (applied to the dB value).
+     */
+    enum class FadeCurve : uint8_t {
+        Linear = 0,     // constant dB per second
+        EaseIn = 1,     // slow start, fast end
+        EaseOut = 2,    // fast start, slow end
+        SCurve = 3      // slow start and end (smoothstep)
+    };
+
+    /**
+     * @brief Cooperative volume ramp scheduler built on top of the chip soft-step.
+     * @details Call update() from loop() and flush the device afterwards (poll() or
+     * sendChangedRegisters()). Each update writes a volume register only when the
+     * curve moved to a new dB value and the previous write of that channel had at
+     * least one soft-step time (register 2) to ramp, so the chip is never driven
+     * faster than it can follow. fadeTo() on a running channel retargets it from
+     * its current level.
+     */
+    class VolumeFader {
+    public:
+        /**
+         * @brief Construct a fader for a device.
+         * @param device Device whose volume registers are ramped.
+         */
+        explicit VolumeFader(TDA7419& device);
+
+        /**
+         * @brief Start (or retarget) a fade.
+         * @param channel Volume stage to fade.
+         * @param targetVolume Target level in range [-80..+15].
+         * @param durationMs Fade duration in milliseconds; 0 jumps on the next update().
+         * Clamped to MAX_FADE_DURATION_MS (about 35 minutes).
+         * @param curve Fade curve.
+         */
+        void fadeTo(FadeChannel channel, int8_t targetVolume, uint32_t durationMs, FadeCurve curve = FadeCurve::Linear);
+
+        /**
+         * @brief Stop a fade at its current level.
+         * @param channel Volume stage.
+         */
+        void stop(FadeChannel channel);
+
+        /**
+         * @brief Stop every running fade.
+         */
+        void stopAll();
+
+        /**
+         * @brief Check whether a channel is fading.
+         * @param channel Volume stage.
+         * @return bool true while the fade has not reached its target.
+         */
+        bool isFading(FadeChannel channel) const;
+
+        /**
+         * @brief Check whether any channel is fading.
+         * @return bool true while at least one fade is running.
+         */
+        bool isActive() const;
+
+        /**
+         * @brief Advance all running fades.
+         * @param nowMicros Current time (defaults to micros()).
+         * @return uint8_t number of volume registers changed in the shadow.
+         */
+        uint8_t update(uint32_t nowMicros);
+        uint8_t update();
+
+        /**
+         * @brief Minimum interval between two writes of the same channel.
+         * @return uint32_t soft-step time configured in register 2, in microseconds.
+         */
+        uint32_t getStepIntervalMicros() const;
+
+    private:
+        struct Fade {
+            int8_t from;
+            int8_t to;
+            FadeCurve curve;
+            bool active;
+            uint32_t startMicros;
+            uint32_t durationMicros;
+            uint32_t lastWriteMicros;
+        };
+
+        TDA7419& dev;
+        std::array<Fade, FADE_CHANNEL_COUNT> fades;
+
+        int8_t getVolume(FadeChannel channel) const;
+        void setVolume(FadeChannel channel, int8_t volume);
+
+        /**
+         * @brief Evaluate a curve.
+         * @param curve Fade curve.
+         * @param progress Elapsed fraction in 1/256 units [0..256].
+         * @return uint16_t curve value in 1/256 units [0..256].
+         */
+        static uint16_t shape(FadeCurve curve, uint16_t progress);
+    };
+
+} // namespace TDA7419
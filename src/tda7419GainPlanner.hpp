@@ -0,0 +1,125 @@
+#pragma once
+
+#include "tda7419.hpp"
+
+namespace TDA7419 {
+
+    /**
+     * @brief Output channels handled by the gain planner.
+     */
+    enum class GainChannel : uint8_t {
+        LeftFront = 0,
+        RightFront = 1,
+        LeftRear = 2,
+        RightRear = 3,
+        Subwoofer = 4
+    };
+
+    constexpr uint8_t GAIN_CHANNEL_COUNT = 5;
+
+    constexpr uint8_t GAIN_MAX_TOLERANCE_DB = 6;
+
+    /**
+     * @brief Noise weight of a stage whose output is followed by gainAfterDb of gain.
+     * @param gainAfterDb Sum of the gains after the stage.
+     * @return uint32_t relative noise power 10^(dB/10) in 1/4096 units (0 below -36 dB,
+     * saturating above +20 dB).
+     */
+    uint32_t gainNoiseWeight(int16_t gainAfterDb);
+
+    /**
+     * @brief Register combination chosen by the gain planner.
+     */
+    struct GainPlan {
+        uint8_t inputGain;                                  // register 0, [0..15] dB
+        int8_t masterVolume;                                // register 3
+        std::array<int8_t, GAIN_CHANNEL_COUNT> channel;     // registers 10..13 and 15
+        uint16_t errorDb;                                   // sum over channels of |reached - requested|
+        uint8_t changedRegisters;                           // registers that differ from the shadow
+        uint32_t noiseWeight;                               // relative output noise power, lower is better
+    };
+
+    /**
+     * @brief Spreads one target level over the gain stages of the chip.
+     * @details The signal path of every output is input gain, loudness attenuation,
+     * master volume and the speaker (or subwoofer) attenuator. For a target level plus a
+     * per-channel trim the planner picks input gain, master and channel volumes so that:
+     * - every channel reaches its level (or the nearest reachable one; the planner stops
+     *   at -79 dB and never uses the -80 mute code);
+     * - no stage ahead of the channel attenuator lifts the source above its headroom
+     *   (setHeadroom(); with the default of 0 the input gain stays at 0 dB);
+     * - output noise is lowest, i.e. gain as early and attenuation as late as possible
+     *   (each stage is modelled as adding equal noise at its output).
+     * Combinations whose noise is within the tolerance of the best are equivalent; among
+     * them the one changing the fewest registers of the current shadow wins, so small
+     * level changes do not reshuffle stages that can stay where they are. Loudness
+     * attenuation is not changed, only compensated. Everything runs on integer dB and
+     * constexpr tables; no register value is converted while searching.
+     */
+    class GainPlanner {
+    public:
+        /**
+         * @brief Construct a planner for a device.
+         * @param device Device whose shadow is read and written.
+         */
+        explicit GainPlanner(TDA7419& device);
+
+        /**
+         * @brief Set a channel trim relative to the target level.
+         * @param channel Output channel.
+         * @param trimDb Trim in dB.
+         */
+        void setTrim(GainChannel channel, int8_t trimDb) { trims[static_cast<uint8_t>(channel)] = trimDb; }
+        int8_t getTrim(GainChannel channel) const { return trims[static_cast<uint8_t>(channel)]; }
+
+        /**
+         * @brief Set how far source peaks sit below the clipping point of the chip.
+         * @param headroomDb Gain allowed ahead of the channel attenuators [0..15] (default 0).
+         * @note The default of 0 assumes full-scale sources: the input gain then stays at
+         * 0 dB and the master never lifts the signal, so every boost comes from the channel
+         * attenuators. Set the real headroom of the source to let the planner move gain
+         * to the input stage, where it adds the least noise.
+         */
+        void setHeadroom(uint8_t headroomDb) { headroom = headroomDb > MAX_INPUT_GAIN ? MAX_INPUT_GAIN : headroomDb; }
+        uint8_t getHeadroom() const { return headroom; }
+
+        /**
+         * @brief Set the noise margin within which combinations count as equivalent.
+         * @param toleranceDb Margin [0..6] dB (default 1); 0 always takes the quietest.
+         */
+        void setTolerance(uint8_t toleranceDb) { tolerance = toleranceDb > GAIN_MAX_TOLERANCE_DB ? GAIN_MAX_TOLERANCE_DB : toleranceDb; }
+        uint8_t getTolerance() const { return tolerance; }
+
+        /**
+         * @brief Compute the register combination for a target level.
+         * @param targetDb Level of the untrimmed channels relative to the source, in dB.
+         * @return GainPlan chosen combination; the device is not touched.
+         */
+        GainPlan plan(int8_t targetDb) const;
+
+        /**
+         * @brief Plan a target level and write it into the device shadow.
+         * @param targetDb Level of the untrimmed channels relative to the source, in dB.
+         * @return GainPlan applied combination; flush the device afterwards.
+         */
+        GainPlan apply(int8_t targetDb);
+
+    private:
+        TDA7419& dev;
+        std::array<int8_t, GAIN_CHANNEL_COUNT> trims;
+        uint8_t headroom = 0;
+        uint8_t tolerance = 1;
+
+        /**
+         * @brief Evaluate one input gain / master combination.
+         * @param gain Input gain.
+         * @param master Master volume.
+         * @param loudness Loudness attenuation (fixed).
+         * @param targets Requested level of every channel.
+         * @param current Current input gain, master and channel volumes of the shadow.
+         * @param out Receives the channel volumes, error, noise and changed registers.
+         */
+        static void evaluate(uint8_t gain, int8_t master, uint8_t loudness, const int16_t* targets, const int8_t* current, GainPlan& out);
+    };
+
+} // namespace TDA7419
@@ -0,0 +1,211 @@
+#pragma once
+
+#include "tda7419.hpp"
+#include <Arduino.h>
+
+namespace TDA7419 {
+
+    /**
+     * @brief Flush scheduler for several TDA7419 devices sharing I2C buses or multiplexers.
+     * @details Devices are kept ordered by bus, then multiplexer and channel, so a flush
+     * finishes one bus before it moves to the next, visits every device behind one channel
+     * before switching to the next, and the number of multiplexer switches stays minimal.
+     * The bus is the TwoWire instance (WireBus) or the i2c-dev descriptor (LinuxI2CBus);
+     * devices on other backends are treated as sharing one bus. The capacity is fixed at
+     * compile time; no heap is used.
+     * @tparam Capacity Maximum number of devices in the group.
+     */
+    template<uint8_t Capacity>
+    class TDA7419Group {
+    public:
+        /**
+         * @brief Traffic counters of one group member.
+         */
+        struct DeviceStats {
+            uint32_t flushes = 0;
+            uint32_t transactions = 0;
+            uint32_t bytes = 0;
+            uint32_t errors = 0;
+            uint32_t busMicros = 0;
+        };
+
+        /**
+         * @brief Add a device to the group.
+         * @param device Device to add; must outlive the group.
+         * @return bool false if the group is full.
+         */
+        bool add(TDA7419& device) {
+            if (count >= Capacity) {
+                return false;
+            }
+
+            // insertion sort on (bus, multiplexer, channel) keeps devices behind one channel together
+            uint8_t pos = count;
+            while (pos > 0 && orderKeyLess(device, *devices[pos - 1])) {
+                devices[pos] = devices[pos - 1];
+                stats[pos] = stats[pos - 1];
+                --pos;
+            }
+            devices[pos] = &device;
+            stats[pos] = DeviceStats();
+            ++count;
+            return true;
+        }
+
+        /**
+         * @brief Number of devices in the group.
+         * @return uint8_t device count.
+         */
+        uint8_t size() const { return count; }
+
+        /**
+         * @brief Access a member in flush order.
+         * @param index Member index [0..size()-1].
+         * @return TDA7419& device.
+         */
+        TDA7419& operator[](uint8_t index) { return *devices[index]; }
+
+        /**
+         * @brief Apply the same change to every device and flush them back-to-back.
+         * @param fn Callable taking a TDA7419&.
+         * @return i2cResult OK, or the first error.
+         * @note All devices receive the change in one bus window, in multiplexer order.
+         */
+        template<typename Fn>
+        i2cResult apply(Fn fn) {
+            for (uint8_t i = 0; i < count; ++i) {
+                fn(*devices[i]);
+            }
+            return flush();
+        }
+
+        /**
+         * @brief Send all pending registers of all devices.
+         * @return i2cResult OK, or the first error (the remaining devices are still flushed).
+         */
+        i2cResult flush() {
+            i2cResult firstError = i2cResult::OK;
+            for (uint8_t i = 0; i < count; ++i) {
+                const i2cResult result = flushDevice(i, UNLIMITED_BUDGET);
+                if (result != i2cResult::OK && firstError == i2cResult::OK) {
+                    firstError = result;
+                }
+            }
+            cursor = 0;
+            return firstError;
+        }
+
+        /**
+         * @brief Send pending registers of the group within a shared time budget.
+         * @param budgetMicros Bus time available for this call in microseconds.
+         * @return i2cResult OK, or the first error.
+         * @note Resumes at the device where the previous call ran out of budget.
+         */
+        i2cResult poll(uint32_t budgetMicros) {
+            const uint32_t start = micros();
+            i2cResult firstError = i2cResult::OK;
+
+            for (uint8_t visited = 0; visited < count; ++visited) {
+                const uint32_t elapsed = micros() - start;
+                if (elapsed >= budgetMicros) {
+                    break;
+                }
+
+                const i2cResult result = flushDevice(cursor, budgetMicros - elapsed);
+                if (result != i2cResult::OK && firstError == i2cResult::OK) {
+                    firstError = result;
+                }
+
+                // out of budget in the middle of this device: continue here next time
+                if (devices[cursor]->isFlushPending() && result == i2cResult::OK) {
+                    break;
+                }
+                cursor = (cursor + 1) % count;
+            }
+
+            return firstError;
+        }
+
+        /**
+         * @brief Check whether any device has registers waiting to be sent.
+         * @return bool true if at least one device is pending.
+         */
+        bool isFlushPending() const {
+            for (uint8_t i = 0; i < count; ++i) {
+                if (devices[i]->isFlushPending()) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @brief Traffic counters of a member.
+         * @param index Member index in flush order.
+         * @return const DeviceStats& counters.
+         */
+        const DeviceStats& getStats(uint8_t index) const { return stats[index]; }
+
+        /**
+         * @brief Reset the traffic counters of all members.
+         */
+        void resetStats() {
+            for (uint8_t i = 0; i < count; ++i) {
+                stats[i] = DeviceStats();
+            }
+        }
+
+    private:
+        static constexpr uint32_t UNLIMITED_BUDGET = 0xFFFFFFFFUL;
+
+        std::array<TDA7419*, Capacity> devices{};
+        std::array<DeviceStats, Capacity> stats{};
+        uint8_t count = 0;
+        uint8_t cursor = 0;
+
+        // identity of the bus a backend drives
+#ifdef TDA7419_WIRE_BUS
+        static uintptr_t busKey(const WireBus& bus) { return reinterpret_cast<uintptr_t>(&bus.getWire()); }
+#endif
+#if defined(__linux__)
+        static uintptr_t busKey(const LinuxI2CBus& bus) { return static_cast<uintptr_t>(bus.getFd()); }
+#endif
+        template<class B>
+        static uintptr_t busKey(const B&) { return 0; }
+
+        static bool orderKeyLess(const TDA7419& a, const TDA7419& b) {
+            const uintptr_t busA = busKey(a.getBus());
+            const uintptr_t busB = busKey(b.getBus());
+            if (busA != busB) {
+                return busA < busB;
+            }
+
+            const uintptr_t muxA = reinterpret_cast<uintptr_t>(a.getBusMux());
+            const uintptr_t muxB = reinterpret_cast<uintptr_t>(b.getBusMux());
+            if (muxA != muxB) {
+                return muxA < muxB;
+            }
+            return a.getBusMuxChannel() < b.getBusMuxChannel();
+        }
+
+        i2cResult flushDevice(uint8_t index, uint32_t budgetMicros) {
+            TDA7419& dev = *devices[index];
+            if (!dev.isFlushPending()) {
+                return i2cResult::OK;
+            }
+
+            FlushReport report;
+            const uint32_t start = micros();
+            const i2cResult result = dev.poll(budgetMicros, &report);
+
+            DeviceStats& s = stats[index];
+            ++s.flushes;
+            s.transactions += report.transactions;
+            s.bytes += report.bytes;
+            s.errors += report.errors;
+            s.busMicros += micros() - start;
+            return result;
+        }
+    };
+
+} // namespace TDA7419
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "tda7419.hpp"
+
+namespace TDA7419 {
+
+    /**
+     * @brief One step of a loudness contour: the register 1 setting used from a master volume down.
+     */
+    struct LoudnessStep {
+        int8_t fromVolume;              // master volume (dB) at and above which the step applies
+        uint8_t attenuation;            // loudness attenuation [0..15] dB
+        LoudnessCenterFreq centerFreq;
+        bool highBoost;                 // high frequency boost on (the register bit is active low)
+    };
+
+    constexpr uint8_t DEFAULT_LOUDNESS_STEP_COUNT = 6;
+
+    // flat at full level, more bass and treble compensation the quieter it gets
+    extern const LoudnessStep DEFAULT_LOUDNESS_CONTOUR[DEFAULT_LOUDNESS_STEP_COUNT];
+
+    constexpr uint8_t DEFAULT_LOUDNESS_HYSTERESIS_DB = 2;
+
+    /**
+     * @brief Loudness compensation that follows the listening level.
+     * @details Maps the master volume to a loudness attenuation, center frequency and
+     * high-boost setting through a contour table. The table lists steps by descending
+     * fromVolume; a volume takes the first step whose fromVolume it reaches, and the
+     * last step covers everything below.
+     *
+     * Register 1 is only written when the volume leaves the current step by more than
+     * the hysteresis, so a volume ramp or an encoder wobbling on a step boundary costs
+     * one loudness write per step instead of one per volume change. Call update() after
+     * changing the volume (e.g. after VolumeFader::update()) and flush the device as usual.
+     * The loudness attenuation lowers the mid-band level; GainPlanner compensates it.
+     */
+    class LoudnessTracker {
+    public:
+        /**
+         * @brief Construct a tracker for a device, using DEFAULT_LOUDNESS_CONTOUR.
+         * @param device Device whose register 1 is written.
+         */
+        explicit LoudnessTracker(TDA7419& device);
+
+        /**
+         * @brief Use a custom contour.
+         * @param steps Steps by descending fromVolume; the table must outlive the tracker.
+         * @param count Number of steps [1..255].
+         * @return bool false for an empty table (the contour is not changed).
+         * @note The next update() applies the new contour unconditionally.
+         */
+        bool setContour(const LoudnessStep* steps, uint8_t count);
+
+        /**
+         * @brief Set the hysteresis around step boundaries.
+         * @param db Distance in dB the volume must move past a boundary (default 2).
+         */
+        void setHysteresis(uint8_t db) { hysteresis = db; }
+        uint8_t getHysteresis() const { return hysteresis; }
+
+        /**
+         * @brief Follow the current master volume of the device shadow.
+         * @return bool true when register 1 was changed.
+         */
+        bool update();
+
+        /**
+         * @brief Follow an explicit listening level (e.g. a fade or GainPlanner target).
+         * @param volume Level in dB on the master volume scale.
+         * @return bool true when register 1 was changed.
+         */
+        bool update(int8_t volume);
+
+        /**
+         * @brief Forget the current step; the next update() writes register 1 unconditionally.
+         */
+        void reset() { stepIndex = NO_STEP; }
+
+        /**
+         * @brief Index of the contour step in effect.
+         * @return uint8_t step index, 0xFF before the first update().
+         */
+        uint8_t getStepIndex() const { return stepIndex; }
+
+    private:
+        static constexpr uint8_t NO_STEP = 0xFF;
+
+        TDA7419& dev;
+        const LoudnessStep* contour = DEFAULT_LOUDNESS_CONTOUR;
+        uint8_t stepCount = DEFAULT_LOUDNESS_STEP_COUNT;
+        uint8_t hysteresis = DEFAULT_LOUDNESS_HYSTERESIS_DB;
+        uint8_t stepIndex = NO_STEP;
+
+        uint8_t stepFor(int16_t volume) const;
+        void apply(uint8_t index);
+    };
+
+} // namespace TDA7419
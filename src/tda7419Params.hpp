@@ -0,0 +1,134 @@
+#pragma once
+
+#include "tda7419.hpp"
+
+namespace TDA7419 {
+
+    /**
+     * @brief Compact identifiers of every TDA7419 setter/getter pair.
+     * @details Values are stable: new parameters are only ever appended.
+     */
+    enum class ParamId : uint8_t {
+        MainSource = 0,
+        InputGain = 1,
+        RearSpeakerSource = 2,
+        SecondSource = 3,
+        SecondSourceInputGain = 4,
+        AutoZero = 5,
+        LoudnessAttenuation = 6,
+        LoudnessCenterFreq = 7,
+        LoudnessHighBoost = 8,
+        LoudnessSoftStep = 9,
+        SoftMute = 10,
+        MutePinEnable = 11,
+        SoftMuteTime = 12,
+        SoftStepTime = 13,
+        ClockFastMode = 14,
+        MasterVolumeSoftStep = 15,
+        MasterVolume = 16,
+        TrebleLevel = 17,
+        TrebleCenterFreq = 18,
+        TrebleReferenceInternal = 19,
+        MiddleSoftStep = 20,
+        MiddleLevel = 21,
+        MiddleQFactor = 22,
+        BassSoftStep = 23,
+        BassLevel = 24,
+        BassQFactor = 25,
+        SmoothingFilter = 26,
+        BassDcMode = 27,
+        BassCenterFreq = 28,
+        MiddleCenterFreq = 29,
+        SubCutoffFreq = 30,
+        MixingGainEffect = 31,
+        SubwooferEnable = 32,
+        MixingEnable = 33,
+        MixToRightFront = 34,
+        MixToLeftFront = 35,
+        SpeakerLFSoftStep = 36,     // SpeakerLFSoftStep + SpeakerChannel
+        SpeakerRFSoftStep = 37,
+        SpeakerLRSoftStep = 38,
+        SpeakerRRSoftStep = 39,
+        SpeakerLFVolume = 40,       // SpeakerLFVolume + SpeakerChannel
+        SpeakerRFVolume = 41,
+        SpeakerLRVolume = 42,
+        SpeakerRRVolume = 43,
+        MixingChannelSoftStep = 44,
+        MixingChannelVolume = 45,
+        SubwooferSoftStep = 46,
+        SubwooferVolume = 47,
+        SpectrumCouplingMode = 48,
+        ExternalClock = 49,
+        SpectrumReset = 50,
+        SpectrumRun = 51,
+        SpectrumSource = 52,
+        SpectrumAutoReset = 53,
+        SpectrumFilterQ = 54
+    };
+
+    constexpr uint8_t PARAM_COUNT = 55;
+    constexpr uint8_t PARAM_NONE = 0xFF;
+
+    // longest parameter key ("trebleReferenceInternal")
+    constexpr uint8_t PARAM_KEY_MAX = 23;
+
+    /**
+     * @brief Value type of a parameter.
+     */
+    enum class ParamKind : uint8_t {
+        Number = 0,     // level or gain in dB
+        Bool = 1,       // 0 / 1, raw register bit as seen by the setter
+        Enum = 2        // index of the setter's enum class
+    };
+
+    /**
+     * @brief Value range and type of a parameter.
+     */
+    struct ParamInfo {
+        int8_t min;
+        int8_t max;
+        ParamKind kind;
+    };
+
+    /**
+     * @brief Describe a parameter.
+     * @param id Parameter identifier [0..PARAM_COUNT-1].
+     * @return ParamInfo range and type; {0, 0, Number} for an unknown id.
+     */
+    ParamInfo getParamInfo(uint8_t id);
+
+    /**
+     * @brief Text key of a parameter, as used by the text serializers.
+     * @param id Parameter identifier.
+     * @return const char* NUL-terminated key in PROGMEM (read with pgm_read_byte), nullptr for an unknown id.
+     */
+    const char* getParamKey(uint8_t id);
+
+    /**
+     * @brief Look up a parameter by its text key.
+     * @param key Key characters (not necessarily NUL-terminated).
+     * @param length Number of key characters.
+     * @return uint8_t parameter identifier, PARAM_NONE if unknown.
+     */
+    uint8_t findParam(const char* key, uint8_t length);
+
+    /**
+     * @brief Read a parameter from the device shadow.
+     * @param dev Device.
+     * @param id Parameter identifier.
+     * @return int16_t current value (0 for an unknown id).
+     * @note No I2C traffic; this is the matching getter.
+     */
+    int16_t getParam(const TDA7419& dev, uint8_t id);
+
+    /**
+     * @brief Write a parameter into the device shadow through its setter.
+     * @param dev Device.
+     * @param id Parameter identifier.
+     * @param value New value.
+     * @return bool false for an unknown id or a value outside the parameter range (nothing changed).
+     * @note Nothing is sent; flush the device afterwards.
+     */
+    bool setParam(TDA7419& dev, uint8_t id, int16_t value);
+
+} // namespace TDA7419
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "tda7419.hpp"
+#include <Arduino.h>
+
+namespace TDA7419 {
+
+    /**
+     * @brief Outcome of PresetBank::recallPreset().
+     */
+    enum class PresetResult : uint8_t {
+        OK = 0,             // preset loaded and sent
+        InvalidSlot = 1,    // no such slot; the device shadow is left untouched
+        SendFailed = 2      // preset loaded into the shadow, the flush failed; changes stay pending
+    };
+
+    /**
+     * @brief Read-only preset images stored in flash (PROGMEM).
+     * @details Declare the table as `const uint8_t table[][REGISTER_COUNT] PROGMEM = {...};`.
+     */
+    class ProgmemPresetStore {
+    public:
+        ProgmemPresetStore(const uint8_t (*images)[REGISTER_COUNT], uint8_t count) : images(images), count(count) {}
+
+        uint8_t size() const { return count; }
+
+        bool load(uint8_t index, RegisterImage& image) const {
+            if (index >= count) {
+                return false;
+            }
+            for (uint8_t reg = 0; reg < REGISTER_COUNT; ++reg) {
+                image[reg] = pgm_read_byte(&images[index][reg]);
+            }
+            return true;
+        }
+
+        bool save(uint8_t, const RegisterImage&) { return false; }
+
+    private:
+        const uint8_t (*images)[REGISTER_COUNT];
+        uint8_t count;
+    };
+
+    /**
+     * @brief Writable preset images kept in RAM.
+     * @tparam Count Number of preset slots.
+     */
+    template<uint8_t Count>
+    class RamPresetStore {
+    public:
+        uint8_t size() const { return Count; }
+
+        bool load(uint8_t index, RegisterImage& image) const {
+            if (index >= Count) {
+                return false;
+            }
+            image = images[index];
+            return true;
+        }
+
+        bool save(uint8_t index, const RegisterImage& image) {
+            if (index >= Count) {
+                return false;
+            }
+            images[index] = image;
+            return true;
+        }
+
+    private:
+        std::array<RegisterImage, Count> images{};
+    };
+
+    /**
+     * @brief Preset images stored in EEPROM, one REGISTER_COUNT-byte record per slot.
+     * @tparam Eeprom EEPROM-like class providing read(int) and write(int, uint8_t)
+     * (e.g. the Arduino EEPROM object). On ESP32 call EEPROM.commit() after saving.
+     */
+    template<typename Eeprom>
+    class EepromPresetStore {
+    public:
+        EepromPresetStore(Eeprom& eeprom, int baseAddress, uint8_t count) : eeprom(eeprom), baseAddress(baseAddress), count(count) {}
+
+        uint8_t size() const { return count; }
+
+        bool load(uint8_t index, RegisterImage& image) const {
+            if (index >= count) {
+                return false;
+            }
+            const int address = baseAddress + index * static_cast<int>(REGISTER_COUNT);
+            for (uint8_t reg = 0; reg < REGISTER_COUNT; ++reg) {
+                image[reg] = eeprom.read(address + reg);
+            }
+            return true;
+        }
+
+        bool save(uint8_t index, const RegisterImage& image) {
+            if (index >= count) {
+                return false;
+            }
+            const int address = baseAddress + index * static_cast<int>(REGISTER_COUNT);
+            for (uint8_t reg = 0; reg < REGISTER_COUNT; ++reg) {
+                // skip unchanged cells to save EEPROM wear
+                if (eeprom.read(address + reg) != image[reg]) {
+                    eeprom.write(address + reg, image[reg]);
+                }
+            }
+            return true;
+        }
+
+    private:
+        Eeprom& eeprom;
+        int baseAddress;
+        uint8_t count;
+    };
+
+    /**
+     * @brief Sound preset bank with diff-based switching.
+     * @details A recall loads the preset image into the device shadow, which marks only
+     * the registers that differ, and sends them as auto-increment bursts. Lookup is O(1)
+     * and no heap is used.
+     * @tparam Store Preset storage (ProgmemPresetStore, RamPresetStore, EepromPresetStore
+     * or any class with size(), load() and save()).
+     */
+    template<typename Store>
+    class PresetBank {
+    public:
+        PresetBank(TDA7419& device, Store& store) : dev(device), store(store) {}
+
+        /**
+         * @brief Number of preset slots.
+         * @return uint8_t slot count.
+         */
+        uint8_t size() const { return store.size(); }
+
+        /**
+         * @brief Switch to a preset, sending only the registers that differ.
+         * @param index Preset slot.
+         * @return PresetResult InvalidSlot if the store has no such slot, SendFailed if the
+         * flush failed (the bus error is reported by the device as for any flush).
+         */
+        PresetResult recallPreset(uint8_t index) {
+            RegisterImage image;
+            if (!store.load(index, image)) {
+                return PresetResult::InvalidSlot;
+            }
+            dev.setRegisterImage(image);
+            return dev.sendChangedRegisters() == i2cResult::OK ? PresetResult::OK : PresetResult::SendFailed;
+        }
+
+        /**
+         * @brief Store the current device settings in a preset slot.
+         * @param index Preset slot.
+         * @return bool false if the slot is invalid or the store is read-only.
+         */
+        bool storePreset(uint8_t index) {
+            RegisterImage image;
+            dev.getRegisterImage(image);
+            return store.save(index, image);
+        }
+
+    private:
+        TDA7419& dev;
+        Store& store;
+    };
+
+} // namespace TDA7419
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "tda7419Params.hpp"
+
+/*
+ * Framed binary command protocol (UART, BLE, ...).
+ *
+ * Frame:  [FRAME_SOF][length][command][payload (length - 1 bytes)][crc lo][crc hi]
+ *
+ * length counts command + payload (1..FRAME_MAX_LENGTH). The CRC is CRC-16/CCITT
+ * (polynomial 0x1021, initial value 0xFFFF) over length, command and payload.
+ * Values are one two's-complement byte, ids are ParamId. A response carries the
+ * request command with FRAME_RESPONSE_BIT set:
+ *
+ *   Ping    ()                          -> ()
+ *   Set     ([id][value])...            -> [applied][rejected][i2cResult]
+ *   SetRun  [first id][value]...        -> [applied][rejected][i2cResult]
+ *   Get     [id]...                     -> ([id][value])... (unknown ids are left out,
+ *                                          at most FRAME_GET_MAX_PAIRS pairs)
+ *   GetAll  ()                          -> [0][value of every parameter in id order]
+ *
+ * Set and SetRun apply all values inside one device transaction, so a frame
+ * costs one coalesced flush whatever the number of parameters. Get and GetAll
+ * are answered from the shadow registers without touching I2C. An unknown
+ * command is answered with FRAME_NAK and the offending command byte; frames
+ * with a bad length or CRC are dropped and counted.
+ */
+
+namespace TDA7419 {
+
+    constexpr uint8_t FRAME_SOF = 0xA5;
+    constexpr uint8_t FRAME_RESPONSE_BIT = 0x80;
+    constexpr uint8_t FRAME_NAK = 0xFF;
+
+    // command + payload; room for one value of every parameter
+    constexpr uint8_t FRAME_MAX_LENGTH = 2 * PARAM_COUNT + 1;
+
+    // SOF, length, CRC
+    constexpr uint8_t FRAME_OVERHEAD = 4;
+
+    // pairs that fit in a Get response; ids requested beyond them (repeats) are left out
+    constexpr uint8_t FRAME_GET_MAX_PAIRS = (FRAME_MAX_LENGTH - 1) / 2;
+
+    /**
+     * @brief Protocol commands.
+     */
+    enum class FrameCommand : uint8_t {
+        Ping = 0x00,
+        Set = 0x01,
+        SetRun = 0x02,
+        Get = 0x03,
+        GetAll = 0x04
+    };
+
+    /**
+     * @brief Callback that sends response bytes to the remote side.
+     * @param context User pointer passed to the FrameProtocol constructor.
+     * @param data Bytes to send.
+     * @param length Number of bytes.
+     */
+    using FrameWriteFn = void (*)(void* context, const uint8_t* data, uint8_t length);
+
+    /**
+     * @brief Update a CRC-16/CCITT with one byte.
+     * @param crc Running CRC (start with 0xFFFF).
+     * @param byte Next byte.
+     * @return uint16_t updated CRC.
+     */
+    uint16_t frameCrc(uint16_t crc, uint8_t byte);
+
+    /**
+     * @brief Build a frame (for the remote side, tests and loopback).
+     * @param command Command byte.
+     * @param payload Payload bytes.
+     * @param length Payload length [0..FRAME_MAX_LENGTH-1].
+     * @param out Receives the frame, FRAME_OVERHEAD + 1 + length bytes.
+     * @return uint8_t frame size, 0 if the payload is too long.
+     */
+    uint8_t encodeFrame(uint8_t command, const uint8_t* payload, uint8_t length, uint8_t* out);
+
+    /**
+     * @brief Device side of the framed protocol.
+     * @details Feed received bytes from loop() or a UART handler context that may
+     * touch the device. A frame is executed once its CRC has checked out; responses
+     * are streamed through the write callback as they are built, so no transmit
+     * buffer is needed. RAM use is one receive frame (FRAME_MAX_LENGTH bytes).
+     */
+    class FrameProtocol {
+    public:
+        /**
+         * @brief Construct a protocol endpoint for a device.
+         * @param device Device controlled by the frames.
+         * @param write Response sink.
+         * @param context User pointer passed to @p write.
+         */
+        FrameProtocol(TDA7419& device, FrameWriteFn write, void* context = nullptr);
+
+        /**
+         * @brief Consume received bytes.
+         * @param byte Next received byte.
+         */
+        void feed(uint8_t byte);
+        void feed(const uint8_t* data, size_t length);
+
+        /**
+         * @brief Frames executed so far.
+         * @return uint32_t frame count.
+         */
+        uint32_t getFrameCount() const { return frames; }
+
+        /**
+         * @brief Frames dropped for a bad length or CRC.
+         * @return uint32_t error count.
+         */
+        uint32_t getErrorCount() const { return errors; }
+
+    private:
+        enum class Rx : uint8_t { Sof, Length, Body, CrcLow, CrcHigh };
+
+        TDA7419& dev;
+        FrameWriteFn writeFn;
+        void* writeContext;
+
+        Rx rx = Rx::Sof;
+        uint8_t length = 0;
+        uint8_t received = 0;
+        uint16_t crc = 0;
+        uint8_t crcLow = 0;
+        uint8_t body[FRAME_MAX_LENGTH];
+
+        uint32_t frames = 0;
+        uint32_t errors = 0;
+
+        // response being streamed
+        uint16_t txCrc = 0;
+
+        void execute();
+        void beginResponse(uint8_t response, uint8_t payloadLength);
+        void emit(const uint8_t* data, uint8_t count);
+        void endResponse();
+        void respondSet(uint8_t command, uint8_t applied, uint8_t rejected, i2cResult result);
+    };
+
+} // namespace TDA7419
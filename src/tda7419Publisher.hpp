@@ -0,0 +1,88 @@
+#pragma once
+
+#include "tda7419.hpp"
+
+namespace TDA7419 {
+
+    /**
+     * @brief Double-buffered register image for glitch-free multi-register updates.
+     * @details Setters keep writing the device shadow, which acts as the back buffer.
+     * publish() snapshots it into a front image and swaps that in atomically; update(),
+     * called from the flusher task, sends the difference between the newest front image
+     * and the image the chip last acknowledged. A group of setters followed by publish()
+     * therefore reaches the chip as a whole: the flusher never sends half of it.
+     *
+     * Neither side waits for the other: three image slots rotate between publish()
+     * (writing one), update() (sending one) and a hand-over slot exchanged atomically
+     * (see tda7419Atomic.hpp). Costs 4 * REGISTER_COUNT bytes of RAM.
+     *
+     * Flush the device through update() only; sendChangedRegisters() and poll() would
+     * send the unpublished shadow. update() clears the device's pending state for every
+     * register the chip has acknowledged with its current shadow value, so
+     * isFlushPending() only reports changes that are not on the chip yet.
+     */
+    class ImagePublisher {
+    public:
+        /**
+         * @brief Construct a publisher for a device.
+         * @param device Device whose shadow is published and which is flushed.
+         * @note The current shadow becomes the first front image. Nothing is known to be
+         * acknowledged yet, so the first update() sends every register.
+         */
+        explicit ImagePublisher(TDA7419& device);
+
+        /**
+         * @brief Make the current shadow the front image.
+         * @note Call from one context at a time (e.g. the task that groups the changes);
+         * setters themselves may run anywhere. Never blocks.
+         */
+        void publish();
+
+        /**
+         * @brief Send the newest published image (flusher side).
+         * @return i2cResult OK, or the first error; registers of failed bursts are retried by the next call.
+         * @note Only registers that differ from the last acknowledged image are sent. A
+         * source change sets the AutoZero remain bit as setMainSource() does.
+         */
+        i2cResult update();
+
+        /**
+         * @brief Registers of the current front image not acknowledged by the chip yet (flusher side).
+         * @return uint32_t bit n set when register n still has to be sent.
+         * @note An image published after the last update() is picked up by the next one.
+         */
+        uint32_t getPendingMask() const;
+
+        /**
+         * @brief Forget the acknowledged image; the next update() sends every register.
+         * @note Use after the chip lost its state (power cycle, brown-out). Flusher side.
+         */
+        void invalidate() { ackedMask = 0; }
+
+        /**
+         * @brief Register image last acknowledged by the chip.
+         * @return const RegisterImage& acknowledged values (see getAcknowledgedMask()).
+         */
+        const RegisterImage& getAcknowledged() const { return acked; }
+
+        /**
+         * @brief Registers of getAcknowledged() known to match the chip.
+         * @return uint32_t bit n set when register n has been acknowledged.
+         */
+        uint32_t getAcknowledgedMask() const { return ackedMask; }
+
+    private:
+        // hand-over slot carries this bit while it holds an image update() has not taken
+        static constexpr uint8_t FRESH = 0x80;
+
+        TDA7419& dev;
+        RegisterImage slots[3];
+        uint8_t writeSlot = 0;      // owned by publish()
+        uint8_t readSlot = 1;       // owned by update()
+        uint8_t handover = 2;       // exchanged atomically
+
+        RegisterImage acked{};
+        uint32_t ackedMask = 0;
+    };
+
+} // namespace TDA7419
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "tda7419.hpp"
+
+namespace TDA7419 {
+
+    // time allowed for the AutoZero offset measurement after a source write
+    constexpr uint32_t DEFAULT_AUTOZERO_MICROS = 1000;
+
+    /**
+     * @brief Steps of a source switch.
+     */
+    enum class SourceSwitchState : uint8_t {
+        Idle = 0,       // no switch in progress
+        Muting = 1,     // soft-mute sent, waiting for the mute ramp
+        Settling = 2,   // source sent, waiting for AutoZero
+        Unmuting = 3    // soft-mute released, waiting for the unmute ramp
+    };
+
+    /**
+     * @brief Non-blocking, click-free main source switch.
+     * @details switchSource() starts the sequence mute, wait for the soft-mute time,
+     * select source and gain, wait for AutoZero, unmute, wait for the unmute ramp.
+     * update() advances it from loop(); every step is one single-register write
+     * (register 2 or register 0) sent straight away, whatever else is pending in the
+     * shadow. Waits are derived from the soft-mute time in register 2 plus the time of
+     * the write itself, so they start when the chip has seen the command. A device that
+     * is already muted stays muted and skips both ramps. Calling switchSource() again
+     * mid-sequence retargets it without unmuting in between. A failed write is retried
+     * on the next update(); see getLastResult().
+     */
+    class SourceSwitcher {
+    public:
+        /**
+         * @brief Construct a switcher for a device.
+         * @param device Device whose main source is switched.
+         */
+        explicit SourceSwitcher(TDA7419& device);
+
+        /**
+         * @brief Start (or retarget) a source switch.
+         * @param source Main source to select.
+         * @param gain Input gain of the new source [0..15].
+         * @param nowMicros Current time (defaults to micros()).
+         * @return bool true if the switch already completed (nothing to do).
+         * @note The first step (mute) is sent from this call.
+         */
+        bool switchSource(InputSource source, uint8_t gain, uint32_t nowMicros);
+        bool switchSource(InputSource source, uint8_t gain);
+
+        /**
+         * @brief Advance the sequence.
+         * @param nowMicros Current time (defaults to micros()).
+         * @return bool true on the call that completes the switch.
+         */
+        bool update(uint32_t nowMicros);
+        bool update();
+
+        /**
+         * @brief Check whether a switch is in progress.
+         * @return bool true until the unmute ramp has finished.
+         */
+        bool isBusy() const { return state != SourceSwitchState::Idle; }
+
+        SourceSwitchState getState() const { return state; }
+
+        /**
+         * @brief Set the time allowed for AutoZero after the source write.
+         * @param waitMicros Wait in microseconds (default DEFAULT_AUTOZERO_MICROS).
+         */
+        void setAutoZeroMicros(uint32_t waitMicros) { autoZeroMicros = waitMicros; }
+        uint32_t getAutoZeroMicros() const { return autoZeroMicros; }
+
+        /**
+         * @brief Duration of a soft-mute or unmute ramp.
+         * @return uint32_t soft-mute time configured in register 2, in microseconds.
+         */
+        uint32_t getMuteMicros() const;
+
+        /**
+         * @brief Result of the last step write.
+         * @return i2cResult OK, or the error that is being retried.
+         */
+        i2cResult getLastResult() const { return lastResult; }
+
+    private:
+        TDA7419& dev;
+        SourceSwitchState state = SourceSwitchState::Idle;
+        InputSource targetSource = InputSource::SE1;
+        uint8_t targetGain = 0;
+        bool keepMuted = false;         // muted before the switch started
+        bool stepSent = false;          // the write of the current step went out
+        uint32_t stepStartMicros = 0;
+        uint32_t stepMicros = 0;
+        uint32_t autoZeroMicros = DEFAULT_AUTOZERO_MICROS;
+        i2cResult lastResult = i2cResult::OK;
+
+        /**
+         * @brief Send the write of the current step.
+         * @return bool true once the write succeeded.
+         */
+        bool sendStep();
+    };
+
+} // namespace TDA7419
@@ -0,0 +1,263 @@
+#pragma once
+
+#include "tda7419.hpp"
+#include <Arduino.h>
+
+namespace TDA7419 {
+
+    constexpr uint8_t SPECTRUM_BAND_COUNT = 7;
+
+    /**
+     * @brief One complete read-out of the 7 spectrum analyzer bands.
+     */
+    struct SpectrumFrame {
+        std::array<uint16_t, SPECTRUM_BAND_COUNT> bands;    // raw ADC readings, lowest band first
+        uint32_t timestampMicros;                           // time the last band was sampled
+    };
+
+    /**
+     * @brief Fixed-size single-producer/single-consumer ring of spectrum frames.
+     * @details push() may run in an ISR while pop() runs in loop() without locks: each
+     * index is written by one side only and published with release/acquire ordering.
+     * One slot is kept free to tell full from empty, so Capacity - 1 frames fit.
+     * @tparam Capacity Number of slots, a power of two in range [2..128].
+     */
+    template<uint8_t Capacity>
+    class SpectrumRing {
+        static_assert(Capacity >= 2 && Capacity <= 128, "SpectrumRing capacity must be in range [2..128]");
+        static_assert((Capacity & (Capacity - 1)) == 0, "SpectrumRing capacity must be a power of two");
+
+    public:
+        /**
+         * @brief Append a frame (producer side).
+         * @param frame Frame to copy into the ring.
+         * @return bool false if the ring was full; the frame is dropped and counted.
+         */
+        bool push(const SpectrumFrame& frame) {
+            const uint8_t h = head;
+            const uint8_t next = (h + 1) & (Capacity - 1);
+            if (next == __atomic_load_n(&tail, __ATOMIC_ACQUIRE)) {
+                ++overruns;
+                return false;
+            }
+            slots[h] = frame;
+            __atomic_store_n(&head, next, __ATOMIC_RELEASE);
+            return true;
+        }
+
+        /**
+         * @brief Take the oldest frame (consumer side).
+         * @param frame Receives the frame.
+         * @return bool false if the ring was empty.
+         */
+        bool pop(SpectrumFrame& frame) {
+            const uint8_t t = tail;
+            if (t == __atomic_load_n(&head, __ATOMIC_ACQUIRE)) {
+                return false;
+            }
+            frame = slots[t];
+            __atomic_store_n(&tail, static_cast<uint8_t>((t + 1) & (Capacity - 1)), __ATOMIC_RELEASE);
+            return true;
+        }
+
+        /**
+         * @brief Number of frames waiting (approximate while the producer runs).
+         * @return uint8_t frame count.
+         */
+        uint8_t available() const {
+            return (__atomic_load_n(&head, __ATOMIC_ACQUIRE) - __atomic_load_n(&tail, __ATOMIC_ACQUIRE)) & (Capacity - 1);
+        }
+
+        /**
+         * @brief Frames dropped because the consumer fell behind.
+         * @return uint16_t overrun count (written by the producer).
+         */
+        uint16_t getOverruns() const { return __atomic_load_n(&overruns, __ATOMIC_RELAXED); }
+
+    private:
+        std::array<SpectrumFrame, Capacity> slots;
+        uint8_t head = 0;       // written by the producer only
+        uint8_t tail = 0;       // written by the consumer only
+        uint16_t overruns = 0;  // written by the producer only
+    };
+
+    /**
+     * @brief Reads one SAOUT sample, e.g. analogRead() of the pin wired to SAOUT.
+     */
+    using SpectrumAdcFn = uint16_t(*)(void* context);
+
+    /**
+     * @brief Drives the external spectrum analyzer clock pin (true = high).
+     */
+    using SpectrumClockFn = void(*)(void* context, bool level);
+
+    /**
+     * @brief Read-out timing of the external clock, in microseconds.
+     * @note Conservative defaults; the settle time depends on the RC load on SAOUT.
+     */
+    struct SpectrumTiming {
+        uint16_t clockHighMicros = 20;      // clock pulse width
+        uint16_t settleMicros = 40;         // clock falling edge to a valid SAOUT level
+        uint32_t framePeriodMicros = 0;     // pause after a frame; 0 reads back-to-back
+    };
+
+    /**
+     * @brief Non-blocking read-out of the 7-band spectrum analyzer.
+     * @details The analyzer runs on the external clock in auto-reset mode: every clock
+     * pulse moves SAOUT to the next band and the peak detectors reset by themselves
+     * after the 7th band, so no I2C traffic is needed once configure() has been flushed.
+     * service() performs at most one step (clock high, clock low, sample) per call and
+     * never waits, so it can run from a timer ISR or from loop(); complete frames are
+     * published into a SpectrumRing that the UI drains with read().
+     * @tparam Capacity Ring size, see SpectrumRing.
+     */
+    template<uint8_t Capacity = 4>
+    class SpectrumReader {
+    public:
+        /**
+         * @brief Construct a reader.
+         * @param adc SAOUT sampling callback.
+         * @param clock Clock pin callback.
+         * @param context Passed to both callbacks.
+         */
+        SpectrumReader(SpectrumAdcFn adc, SpectrumClockFn clock, void* context = nullptr)
+            : adcFn(adc), clockFn(clock), callbackContext(context) {}
+
+        /**
+         * @brief Set the analyzer registers for this reader in the device shadow.
+         * @param device Device to configure; flush it afterwards.
+         * @param source Filter input of the analyzer.
+         * @param q Band filter Q.
+         * @note Selects external clock and auto-reset, releases reset and starts the
+         * analyzer (register 16: run and reset bits are active-low on the chip).
+         */
+        static void configure(TDA7419& device, SpectrumSource source = SpectrumSource::Bass, SpectrumFilterQ q = SpectrumFilterQ::Q3_5) {
+            device.setSpectrumSource(source);
+            device.setSpectrumFilterQ(q);
+            device.setExternalClock(true);
+            device.setSpectrumAutoReset(true);
+            device.setSpectrumReset(true);
+            device.setSpectrumRun(false);
+        }
+
+        /**
+         * @brief Change the read-out timing.
+         * @param value New timing; applies from the next step.
+         */
+        void setTiming(const SpectrumTiming& value) { timing = value; }
+        const SpectrumTiming& getTiming() const { return timing; }
+
+        /**
+         * @brief Start reading at band 0.
+         * @param nowMicros Current time (defaults to micros()).
+         * @note Call after the configuration has been flushed, which resets the band counter.
+         */
+        void start(uint32_t nowMicros) {
+            band = 0;
+            phase = Phase::ClockHigh;
+            deadline = nowMicros;
+            running = true;
+        }
+        void start() { start(micros()); }
+
+        /**
+         * @brief Stop reading; a partial frame is discarded.
+         * @note The clock is left low. Call start() to resynchronise.
+         */
+        void stop() {
+            running = false;
+            clockFn(callbackContext, false);
+        }
+
+        bool isRunning() const { return running; }
+
+        /**
+         * @brief Advance the read-out by at most one step (producer side).
+         * @param nowMicros Current time (defaults to micros()).
+         * @return bool true if this call completed and published a frame.
+         */
+        bool service(uint32_t nowMicros) {
+            if (!running || static_cast<int32_t>(nowMicros - deadline) < 0) {
+                return false;
+            }
+
+            switch (phase) {
+            case Phase::ClockHigh:
+                clockFn(callbackContext, true);
+                phase = Phase::ClockLow;
+                deadline = nowMicros + timing.clockHighMicros;
+                return false;
+
+            case Phase::ClockLow:
+                // the falling edge moves SAOUT to the next band
+                clockFn(callbackContext, false);
+                phase = Phase::Sample;
+                deadline = nowMicros + timing.settleMicros;
+                return false;
+
+            case Phase::Sample:
+            default:
+                frame.bands[band] = adcFn(callbackContext);
+                phase = Phase::ClockHigh;
+                deadline = nowMicros;
+                if (++band < SPECTRUM_BAND_COUNT) {
+                    return false;
+                }
+
+                // the chip resets its peak detectors itself after the last band
+                band = 0;
+                frame.timestampMicros = nowMicros;
+                deadline = nowMicros + timing.framePeriodMicros;
+                return ring.push(frame);
+            }
+        }
+        bool service() { return service(micros()); }
+
+        /**
+         * @brief Take the oldest complete frame (consumer side).
+         * @param out Receives the frame.
+         * @return bool false if no frame is waiting.
+         */
+        bool read(SpectrumFrame& out) { return ring.pop(out); }
+
+        /**
+         * @brief Number of complete frames waiting.
+         * @return uint8_t frame count.
+         */
+        uint8_t available() const { return ring.available(); }
+
+        /**
+         * @brief Frames dropped because read() was not called often enough.
+         * @return uint16_t overrun count.
+         */
+        uint16_t getOverruns() const { return ring.getOverruns(); }
+
+        /**
+         * @brief Minimum time to read one frame with the current timing.
+         * @return uint32_t microseconds, excluding the frame period.
+         */
+        uint32_t getFrameMicros() const {
+            return static_cast<uint32_t>(SPECTRUM_BAND_COUNT) * (timing.clockHighMicros + timing.settleMicros);
+        }
+
+    private:
+        enum class Phase : uint8_t {
+            ClockHigh,
+            ClockLow,
+            Sample
+        };
+
+        SpectrumAdcFn adcFn;
+        SpectrumClockFn clockFn;
+        void* callbackContext;
+        SpectrumTiming timing;
+
+        SpectrumRing<Capacity> ring;
+        SpectrumFrame frame{};
+        uint32_t deadline = 0;
+        uint8_t band = 0;
+        Phase phase = Phase::ClockHigh;
+        bool running = false;
+    };
+
+} // namespace TDA7419
@@ -0,0 +1,222 @@
+#pragma once
+
+#include "tda7419Params.hpp"
+#include <Arduino.h>
+
+/*
+ * Device state import/export.
+ *
+ * Binary format: STATE_BINARY_MAGIC, then runs of
+ *   [first parameter id][count][count values]
+ * with every value one two's-complement byte. The full state is a single run of
+ * 3 + PARAM_COUNT bytes; one changed parameter costs 4 bytes. Values of a run that
+ * reach past the last parameter are rejected.
+ *
+ * Text format: key=value pairs separated by newlines, ';' or ',', or a flat JSON
+ * object with numeric or true/false values:
+ *   masterVolume=-20
+ *   {"masterVolume":-20,"bassLevel":3,"loudnessHighBoost":true}
+ * Keys are the getParamKey() names. Unknown keys and out-of-range values are
+ * skipped and counted, so a newer app can talk to an older firmware.
+ */
+
+namespace TDA7419 {
+
+    // first byte of a binary state message
+    constexpr uint8_t STATE_BINARY_MAGIC = 0xA7;
+
+    /**
+     * @brief Text layout written by writeStateText().
+     */
+    enum class StateTextFormat : uint8_t {
+        KeyValue = 0,   // one key=value line per parameter
+        Json = 1        // one flat JSON object
+    };
+
+    /**
+     * @brief Format a value as decimal text.
+     * @param value Value to format.
+     * @param out Receives at least 6 characters (not NUL-terminated).
+     * @return uint8_t number of characters written.
+     */
+    uint8_t formatStateNumber(int16_t value, char* out);
+
+    /**
+     * @brief Write the full device state in the binary format.
+     * @tparam Out Byte sink with write(uint8_t), e.g. Serial or any Print.
+     * @param dev Device whose shadow is read.
+     * @param out Sink.
+     * @return size_t bytes written (3 + PARAM_COUNT).
+     */
+    template<class Out>
+    size_t writeStateBinary(const TDA7419& dev, Out& out) {
+        out.write(STATE_BINARY_MAGIC);
+        out.write(static_cast<uint8_t>(0));
+        out.write(PARAM_COUNT);
+        for (uint8_t id = 0; id < PARAM_COUNT; ++id) {
+            out.write(static_cast<uint8_t>(getParam(dev, id)));
+        }
+        return 3 + PARAM_COUNT;
+    }
+
+    /**
+     * @brief Write the full device state as text.
+     * @tparam Out Byte sink with write(uint8_t), e.g. Serial or any Print.
+     * @param dev Device whose shadow is read.
+     * @param out Sink.
+     * @param format Key=value lines or a JSON object.
+     * @return size_t bytes written.
+     * @note Streams straight from the shadow and PROGMEM keys; nothing is buffered.
+     */
+    template<class Out>
+    size_t writeStateText(const TDA7419& dev, Out& out, StateTextFormat format = StateTextFormat::KeyValue) {
+        const bool json = format == StateTextFormat::Json;
+        size_t written = 0;
+        if (json) {
+            out.write(static_cast<uint8_t>('{'));
+            ++written;
+        }
+
+        for (uint8_t id = 0; id < PARAM_COUNT; ++id) {
+            if (json) {
+                if (id > 0) {
+                    out.write(static_cast<uint8_t>(','));
+                    ++written;
+                }
+                out.write(static_cast<uint8_t>('"'));
+                ++written;
+            }
+            for (const char* key = getParamKey(id); ; ++key) {
+                const uint8_t c = pgm_read_byte(key);
+                if (c == 0) {
+                    break;
+                }
+                out.write(c);
+                ++written;
+            }
+            if (json) {
+                out.write(static_cast<uint8_t>('"'));
+                ++written;
+            }
+            out.write(static_cast<uint8_t>(json ? ':' : '='));
+            ++written;
+
+            const int16_t value = getParam(dev, id);
+            if (json && getParamInfo(id).kind == ParamKind::Bool) {
+                const char* word = value != 0 ? "true" : "false";
+                for (; *word != 0; ++word) {
+                    out.write(static_cast<uint8_t>(*word));
+                    ++written;
+                }
+            }
+            else {
+                char digits[6];
+                const uint8_t length = formatStateNumber(value, digits);
+                for (uint8_t i = 0; i < length; ++i) {
+                    out.write(static_cast<uint8_t>(digits[i]));
+                }
+                written += length;
+            }
+
+            if (!json) {
+                out.write(static_cast<uint8_t>('\n'));
+                ++written;
+            }
+        }
+
+        if (json) {
+            out.write(static_cast<uint8_t>('}'));
+            ++written;
+        }
+        return written;
+    }
+
+    /**
+     * @brief Streaming state importer.
+     * @details Detects the format from the first byte (STATE_BINARY_MAGIC or text) and
+     * applies every parameter to the device shadow through its setter as soon as its
+     * last byte arrives; nothing but the current key is buffered and no heap is used.
+     * begin() opens a transaction (beginUpdate()), so a poll() running meanwhile
+     * sends nothing; end() commits it with one coalesced flush.
+     */
+    class StateParser {
+    public:
+        /**
+         * @brief Construct a parser for a device.
+         * @param device Device whose shadow receives the parameters.
+         */
+        explicit StateParser(TDA7419& device);
+
+        /**
+         * @brief Start a message (opens a device transaction).
+         */
+        void begin();
+
+        /**
+         * @brief Consume message bytes; calls begin() if needed.
+         * @param byte Next byte of the message.
+         */
+        void feed(uint8_t byte);
+        void feed(const uint8_t* data, size_t length);
+
+        /**
+         * @brief Finish the message and flush all changed registers at once.
+         * @return i2cResult result of the flush.
+         */
+        i2cResult end();
+
+        /**
+         * @brief Drop the message and restore the shadow as it was before begin().
+         * @note Rolls back the device transaction (abort()).
+         */
+        void cancel();
+
+        /**
+         * @brief Parameters applied from the current (or last) message.
+         * @return uint16_t applied count.
+         */
+        uint16_t getApplied() const { return applied; }
+
+        /**
+         * @brief Parameters skipped: unknown key, value out of range, syntax error or truncation.
+         * @return uint16_t rejected count.
+         */
+        uint16_t getRejected() const { return rejected; }
+
+    private:
+        enum class Step : uint8_t {
+            Detect,
+            RunId,          // binary: first parameter of a run
+            RunCount,       // binary: number of values in the run
+            RunValues,      // binary: values
+            Idle,           // text: between pairs
+            Key,
+            AfterKey,       // text: key done, waiting for '=' or ':'
+            ValueStart,
+            Number,
+            Word,           // text: true / false
+            Skip            // text: rest of a rejected pair
+        };
+
+        TDA7419& dev;
+        bool active = false;
+        Step step = Step::Detect;
+        uint8_t paramId = PARAM_NONE;
+        uint8_t remaining = 0;
+        char key[PARAM_KEY_MAX];
+        uint8_t keyLength = 0;
+        bool keyOverflow = false;
+        bool negative = false;
+        int16_t value = 0;
+        const char* word = nullptr;
+        uint8_t wordIndex = 0;
+        uint16_t applied = 0;
+        uint16_t rejected = 0;
+
+        void feedBinary(uint8_t byte);
+        void feedText(char c);
+        void apply();
+        void lookupKey();
+    };
+
+} // namespace TDA7419